@@ -0,0 +1,178 @@
+/*
+ * Asset Watch - inotify watcher thread and decoded-surface hand-off
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+#include "asset_watch.h"
+#include <SDL2/SDL_image.h>
+#include <stdio.h>
+#include <string.h>
+#include "trace.h"
+
+#ifdef __linux__
+
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#define WATCH_POLL_MS 100
+#define WATCH_EVENT_BUF 4096
+
+static SDL_Thread* watch_thread = NULL;
+static SDL_mutex* pending_lock = NULL;
+static AssetReload pending[ASSET_MAX_PENDING];
+static int pending_count = 0;
+static int watch_fd = -1;
+static SDL_atomic_t watch_running;
+static char watch_dir[256];
+
+/* Check if a file name ends with .png */
+static int is_png(const char* name) {
+    size_t len = strlen(name);
+    return len > 4 && strcmp(name + len - 4, ".png") == 0;
+}
+
+/* Queue a decoded surface, replacing any older copy of the same file */
+static void push_pending(const char* name, SDL_Surface* surface) {
+    SDL_LockMutex(pending_lock);
+    for (int i = 0; i < pending_count; i++) {
+        if (strcmp(pending[i].name, name) == 0) {
+            SDL_FreeSurface(pending[i].surface);
+            pending[i].surface = surface;
+            SDL_UnlockMutex(pending_lock);
+            return;
+        }
+    }
+    if (pending_count < ASSET_MAX_PENDING) {
+        snprintf(pending[pending_count].name, ASSET_NAME_LEN, "%s", name);
+        pending[pending_count].surface = surface;
+        pending_count++;
+    } else {
+        SDL_FreeSurface(surface);
+    }
+    SDL_UnlockMutex(pending_lock);
+}
+
+/* Decode a changed file off the render thread */
+static void reload_file(const char* name) {
+    TRACE_SCOPE("asset_decode");
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s", watch_dir, name);
+    
+    /* A half-written file fails to decode; its final close will fire again */
+    SDL_Surface* surface = IMG_Load(path);
+    if (!surface) {
+        printf("Hot reload skipped %s: %s\n", path, IMG_GetError());
+        return;
+    }
+    push_pending(name, surface);
+}
+
+/* Watcher thread - wakes periodically so asset_watch_stop() can end it */
+static int watch_main(void* data) {
+    (void)data;
+    TRACE_THREAD_NAME("asset watch");
+    char buf[WATCH_EVENT_BUF] __attribute__((aligned(__alignof__(struct inotify_event))));
+    struct pollfd pfd = {watch_fd, POLLIN, 0};
+    
+    while (SDL_AtomicGet(&watch_running)) {
+        if (poll(&pfd, 1, WATCH_POLL_MS) <= 0) continue;
+        
+        ssize_t len = read(watch_fd, buf, sizeof(buf));
+        for (char* p = buf; len > 0 && p < buf + len; ) {
+            struct inotify_event* ev = (struct inotify_event*)p;
+            if (ev->len > 0 && is_png(ev->name) && strlen(ev->name) < ASSET_NAME_LEN) {
+                reload_file(ev->name);
+            }
+            p += sizeof(struct inotify_event) + ev->len;
+        }
+    }
+    return 0;
+}
+
+/* Start watching dir for rewritten images - returns 0 on success */
+int asset_watch_start(const char* dir) {
+    if (SDL_AtomicGet(&watch_running)) return 0;
+    
+    snprintf(watch_dir, sizeof(watch_dir), "%s", dir);
+    watch_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watch_fd < 0) {
+        printf("Asset watch failed: inotify unavailable\n");
+        return -1;
+    }
+    
+    /* Editors either rewrite in place (close-write) or rename over the old file */
+    if (inotify_add_watch(watch_fd, dir, IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        printf("Asset watch failed: cannot watch %s\n", dir);
+        close(watch_fd);
+        watch_fd = -1;
+        return -1;
+    }
+    
+    pending_lock = SDL_CreateMutex();
+    SDL_AtomicSet(&watch_running, 1);
+    watch_thread = SDL_CreateThread(watch_main, "asset_watch", NULL);
+    if (!pending_lock || !watch_thread) {
+        printf("Asset watch failed: %s\n", SDL_GetError());
+        asset_watch_stop();
+        return -1;
+    }
+    
+    printf("Watching %s for asset changes\n", dir);
+    return 0;
+}
+
+/* Take up to max decoded surfaces - never blocks on the watcher */
+int asset_watch_poll(AssetReload* out, int max) {
+    if (!pending_lock || SDL_TryLockMutex(pending_lock) != 0) return 0;
+    
+    int count = pending_count < max ? pending_count : max;
+    memcpy(out, pending, count * sizeof(AssetReload));
+    memmove(pending, pending + count, (pending_count - count) * sizeof(AssetReload));
+    pending_count -= count;
+    
+    SDL_UnlockMutex(pending_lock);
+    return count;
+}
+
+/* Stop the watcher thread and drop anything not yet collected */
+void asset_watch_stop() {
+    SDL_AtomicSet(&watch_running, 0);
+    if (watch_thread) {
+        SDL_WaitThread(watch_thread, NULL);
+        watch_thread = NULL;
+    }
+    if (watch_fd >= 0) {
+        close(watch_fd);
+        watch_fd = -1;
+    }
+    if (pending_lock) {
+        for (int i = 0; i < pending_count; i++) {
+            SDL_FreeSurface(pending[i].surface);
+        }
+        pending_count = 0;
+        SDL_DestroyMutex(pending_lock);
+        pending_lock = NULL;
+    }
+}
+
+#else
+
+int asset_watch_start(const char* dir) {
+    printf("Asset watch is only supported on Linux, not watching %s\n", dir);
+    return -1;
+}
+
+int asset_watch_poll(AssetReload* out, int max) {
+    (void)out;
+    (void)max;
+    return 0;
+}
+
+void asset_watch_stop() {
+}
+
+#endif
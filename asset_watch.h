@@ -0,0 +1,30 @@
+/*
+ * Asset Watch - hot-reload of res/ images while the game runs
+ * Linux only (inotify); elsewhere asset_watch_start() reports failure.
+ *
+ * A background thread waits for files in the watched directory to be
+ * rewritten and decodes them straight away with IMG_Load. The render
+ * thread collects the decoded surfaces between frames with
+ * asset_watch_poll() and turns them into textures itself, since SDL
+ * textures may only be created on the thread that owns the renderer.
+ */
+
+#ifndef ASSET_WATCH_H
+#define ASSET_WATCH_H
+
+#include <SDL2/SDL.h>
+
+#define ASSET_NAME_LEN 64
+#define ASSET_MAX_PENDING 64
+
+/* A changed file, already decoded - the receiver owns the surface */
+typedef struct {
+    char name[ASSET_NAME_LEN];
+    SDL_Surface* surface;
+} AssetReload;
+
+int asset_watch_start(const char* dir);
+int asset_watch_poll(AssetReload* out, int max);
+void asset_watch_stop();
+
+#endif
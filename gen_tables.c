@@ -0,0 +1,342 @@
+/*
+ * Table Generator - writes poker_tables.c for variant_evaluate()
+ * Run by the Makefile at build time:
+ *
+ *   ./gen_tables > poker_tables.c
+ *
+ * Every shape of hand a variant can meet is scored here the slow way,
+ * trying every value of every wild card, so the game only ever looks the
+ * answer up. Scores are ranked densely per variant, and each one also gets
+ * the share of the variant's possible hands it beats, counted from the
+ * number of real card combinations behind every table entry.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "poker_core.h"
+#include "poker_variant.h"
+#include "poker_variant_spec.h"
+
+#define RANKS 13
+#define MAX_KEYS (VARIANT_RANKS_SIZE + VARIANT_FLUSH_SIZE)
+
+static uint16_t colex[HAND_SIZE][WILD_INDEX + 1];
+static double binom[64][HAND_SIZE + 1];
+
+/* Per-entry raw keys and how many real hands land on each */
+static uint32_t rank_key[VARIANT_RANKS_SIZE];
+static uint8_t rank_class[VARIANT_RANKS_SIZE];
+static uint8_t rank_high[VARIANT_RANKS_SIZE];
+static double rank_weight[VARIANT_RANKS_SIZE];
+static int rank_used[VARIANT_RANKS_SIZE];
+static uint32_t flush_key[VARIANT_FLUSH_SIZE];
+static uint8_t flush_class[VARIANT_FLUSH_SIZE];
+static uint8_t flush_high[VARIANT_FLUSH_SIZE];
+static double flush_weight[VARIANT_FLUSH_SIZE];
+static int flush_used[VARIANT_FLUSH_SIZE];
+
+/* Wild cards in a variant's deck: its jokers, or all four of a wild rank */
+static int wild_cards(const VariantInfo* spec) {
+    return spec->jokers + (spec->wild != 0 && spec->wild != JOKER ? 4 : 0);
+}
+
+/* Rank index 0..12 that never appears as a natural card, or -1 */
+static int wild_rank(const VariantInfo* spec) {
+    return spec->wild != 0 && spec->wild != JOKER ? (int)spec->wild - TWO : -1;
+}
+
+static void build_binomials() {
+    for (int n = 0; n < 64; n++) {
+        binom[n][0] = 1.0;
+        for (int k = 1; k <= HAND_SIZE; k++) {
+            binom[n][k] = n == 0 ? 0.0 : binom[n - 1][k - 1] + binom[n - 1][k];
+        }
+    }
+    for (int i = 0; i < HAND_SIZE; i++) {
+        for (int r = 0; r < RANKS; r++) {
+            colex[i][r] = (uint16_t)binom[r + i][i + 1];
+        }
+        colex[i][WILD_INDEX] = 0;
+    }
+}
+
+/*
+ * Raw key for five ranks (0 = two .. 12 = ace) under a rule - bigger is
+ * better, comparable only within the rule. The class to show and the top
+ * card come back through cls and high.
+ */
+static uint32_t score_ranks(VariantRule rule, const int* ranks, int suited, int* cls, int* high) {
+    int counts[RANKS] = {0};
+    for (int i = 0; i < HAND_SIZE; i++) {
+        counts[ranks[i]]++;
+    }
+    
+    /* Order value: the ace sits below the two in A-5 */
+    int order[RANKS];
+    for (int r = 0; r < RANKS; r++) {
+        order[r] = rule == RULE_ACE_FIVE ? (r == RANKS - 1 ? 0 : r + 1) : r + 1;
+    }
+    
+    /* Kickers by group size, then order value */
+    int kickers[HAND_SIZE];
+    int groups = 0;
+    for (int size = HAND_SIZE; size >= 1; size--) {
+        for (int v = RANKS; v >= 0; v--) {
+            for (int r = 0; r < RANKS; r++) {
+                if (order[r] == v && counts[r] == size) kickers[groups++] = r;
+            }
+        }
+    }
+    int top = counts[kickers[0]];
+    int second = groups > 1 ? counts[kickers[1]] : 0;
+    
+    int straight = 0, wheel = 0;
+    if (groups == HAND_SIZE && rule != RULE_ACE_FIVE) {
+        if (order[kickers[0]] - order[kickers[4]] == 4) {
+            straight = 1;
+        } else if (rule == RULE_HIGH && kickers[0] == 12 && kickers[1] == 3) {
+            straight = wheel = 1;
+        }
+    }
+    int flush = suited && rule != RULE_ACE_FIVE;
+    
+    HandRank c;
+    if (top == 5) c = FIVE_OF_KIND;
+    else if (straight && flush) c = STRAIGHT_FLUSH;
+    else if (top == 4) c = FOUR_OF_KIND;
+    else if (top == 3 && second == 2) c = FULL_HOUSE;
+    else if (flush) c = FLUSH;
+    else if (straight) c = STRAIGHT;
+    else if (top == 3) c = THREE_OF_KIND;
+    else if (top == 2 && second == 2) c = TWO_PAIR;
+    else if (top == 2) c = PAIR;
+    else c = HIGH_CARD;
+    
+    uint32_t key = c;
+    for (int i = 0; i < HAND_SIZE; i++) {
+        int v = i < groups ? order[kickers[i]] : 0;
+        if (wheel) v = i < 4 ? 4 - i : 0;
+        key = key << 4 | v;
+    }
+    
+    *cls = c;
+    *high = wheel ? FIVE : kickers[0] + TWO;
+    return rule == RULE_HIGH ? key : (1u << 24) - key;
+}
+
+/* Best key over every value of the wilds after ranks[0..filled), optionally as a suited hand */
+static uint32_t best_key(VariantRule rule, int* ranks, int filled, int suited, int* cls, int* high) {
+    if (filled == HAND_SIZE) {
+        if (suited) {
+            /* A suited hand can't hold the same card twice */
+            for (int i = 0; i < HAND_SIZE; i++) {
+                for (int j = i + 1; j < HAND_SIZE; j++) {
+                    if (ranks[i] == ranks[j]) return 0;
+                }
+            }
+        }
+        return score_ranks(rule, ranks, suited, cls, high);
+    }
+    uint32_t best = 0;
+    for (int r = 0; r < RANKS; r++) {
+        ranks[filled] = r;
+        int c, h;
+        uint32_t key = best_key(rule, ranks, filled + 1, suited, &c, &h);
+        if (key > best) {
+            best = key;
+            *cls = c;
+            *high = h;
+        }
+    }
+    return best;
+}
+
+/* Walk the multisets of k natural ranks, each rank at least `from`, filling in ranks table entries */
+static void fill_ranks(const VariantInfo* spec, int* ranks, int k, int filled, int from, int wilds) {
+    if (filled == k) {
+        int index = wild_offset[wilds];
+        double combos = binom[wild_cards(spec)][wilds];
+        int distinct = 1;
+        for (int i = 0; i < k; i++) {
+            index += colex[i][ranks[i]];
+            int same = 1;
+            for (int j = i + 1; j < k && ranks[j] == ranks[i]; j++) same++;
+            if (i == 0 || ranks[i] != ranks[i - 1]) combos *= binom[4][same];
+            if (i > 0 && ranks[i] == ranks[i - 1]) distinct = 0;
+        }
+        
+        /* All-one-suit hands of distinct ranks are the flush table's */
+        if (distinct) combos -= binom[wild_cards(spec)][wilds] * 4;
+        
+        int work[HAND_SIZE], c = HIGH_CARD, h = TWO;
+        memcpy(work, ranks, k * sizeof(int));
+        rank_key[index] = best_key(spec->rule, work, k, 0, &c, &h);
+        rank_class[index] = c;
+        rank_high[index] = h;
+        rank_weight[index] = combos;
+        rank_used[index] = 1;
+        return;
+    }
+    for (int r = from; r < RANKS; r++) {
+        if (r == wild_rank(spec)) continue;
+        int same = 0;
+        for (int i = 0; i < filled; i++) same += ranks[i] == r;
+        if (same == 4) continue;
+        ranks[filled] = r;
+        fill_ranks(spec, ranks, k, filled + 1, r, wilds);
+    }
+}
+
+/* Flush table: k distinct natural ranks in one suit plus the wilds */
+static void fill_flushes(const VariantInfo* spec, int wilds) {
+    int k = HAND_SIZE - wilds;
+    for (int mask = 0; mask < VARIANT_FLUSH_SIZE; mask++) {
+        if (__builtin_popcount(mask) != k) continue;
+        if (wild_rank(spec) >= 0 && (mask & 1 << wild_rank(spec))) continue;
+        
+        int ranks[HAND_SIZE], n = 0;
+        for (int r = 0; r < RANKS; r++) {
+            if (mask & (1 << r)) ranks[n++] = r;
+        }
+        int c = HIGH_CARD, h = TWO;
+        uint32_t key = best_key(spec->rule, ranks, k, 1, &c, &h);
+        if (wilds > 0) {
+            /* The wilds may just as well play off-suit */
+            int c2, h2;
+            uint32_t loose = best_key(spec->rule, ranks, k, 0, &c2, &h2);
+            if (loose > key) {
+                key = loose;
+                c = c2;
+                h = h2;
+            }
+        }
+        flush_key[mask] = key;
+        flush_class[mask] = c;
+        flush_high[mask] = h;
+        flush_weight[mask] = binom[wild_cards(spec)][wilds] * 4;
+        flush_used[mask] = 1;
+    }
+}
+
+static int compare_keys(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+    return x < y ? -1 : x > y;
+}
+
+/* Dense score of a raw key: its position among the variant's distinct keys, from 1 */
+static int dense_score(const uint32_t* keys, int n, uint32_t key) {
+    int lo = 0, hi = n - 1;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (keys[mid] < key) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo + 1;
+}
+
+static void print_u32(const char* name, const char* variant, const uint32_t* values, int n) {
+    printf("static const uint32_t variant_%s_%s[%d] = {", variant, name, n);
+    for (int i = 0; i < n; i++) {
+        printf("%s0x%06x,", i % 8 ? " " : "\n    ", values[i]);
+    }
+    printf("\n};\n\n");
+}
+
+static void generate(const VariantInfo* spec) {
+    memset(rank_used, 0, sizeof(rank_used));
+    memset(flush_used, 0, sizeof(flush_used));
+    int max_wilds = wild_cards(spec) < HAND_SIZE - 1 ? wild_cards(spec) : HAND_SIZE - 1;
+    for (int w = 0; w <= max_wilds; w++) {
+        int ranks[HAND_SIZE];
+        fill_ranks(spec, ranks, HAND_SIZE - w, 0, 0, w);
+        fill_flushes(spec, w);
+    }
+    int rank_size = wild_offset[max_wilds + 1];
+    
+    /* Distinct keys in order give the dense scores */
+    static uint32_t keys[MAX_KEYS];
+    int n = 0;
+    for (int i = 0; i < rank_size; i++) {
+        if (rank_used[i] && rank_weight[i] > 0) keys[n++] = rank_key[i];
+    }
+    for (int i = 0; i < VARIANT_FLUSH_SIZE; i++) {
+        if (flush_used[i]) keys[n++] = flush_key[i];
+    }
+    qsort(keys, n, sizeof(uint32_t), compare_keys);
+    int distinct = 0;
+    for (int i = 0; i < n; i++) {
+        if (distinct == 0 || keys[i] != keys[distinct - 1]) keys[distinct++] = keys[i];
+    }
+    
+    /* Real hands behind each score, for the share each one beats */
+    static double per_score[MAX_KEYS + 1];
+    memset(per_score, 0, sizeof(per_score));
+    static uint32_t ranks_out[VARIANT_RANKS_SIZE], flush_out[VARIANT_FLUSH_SIZE];
+    memset(ranks_out, 0, sizeof(ranks_out));
+    memset(flush_out, 0, sizeof(flush_out));
+    double total = 0.0;
+    for (int i = 0; i < rank_size; i++) {
+        if (!rank_used[i]) continue;
+        int score = dense_score(keys, distinct, rank_key[i]);
+        ranks_out[i] = (uint32_t)score | (uint32_t)rank_class[i] << 16 | (uint32_t)rank_high[i] << 20;
+        per_score[score] += rank_weight[i];
+        total += rank_weight[i];
+    }
+    for (int i = 0; i < VARIANT_FLUSH_SIZE; i++) {
+        if (!flush_used[i]) continue;
+        int score = dense_score(keys, distinct, flush_key[i]);
+        flush_out[i] = (uint32_t)score | (uint32_t)flush_class[i] << 16 | (uint32_t)flush_high[i] << 20;
+        per_score[score] += flush_weight[i];
+        total += flush_weight[i];
+    }
+    
+    int deck = (wild_rank(spec) < 0 ? DECK_SIZE : DECK_SIZE - 4) + wild_cards(spec);
+    if (total != binom[deck][HAND_SIZE]) {
+        fprintf(stderr, "gen_tables: %s covers %.0f hands, expected %.0f\n", spec->name, total,
+                binom[deck][HAND_SIZE]);
+        exit(1);
+    }
+    
+    printf("/* %s: %d scores over %.0f hands */\n", spec->name, distinct, total);
+    print_u32("ranks", spec->key, ranks_out, rank_size);
+    print_u32("flush", spec->key, flush_out, VARIANT_FLUSH_SIZE);
+    
+    printf("static const uint16_t variant_%s_beats[%d] = {", spec->key, distinct + 1);
+    double below = 0.0;
+    for (int s = 0; s <= distinct; s++) {
+        int permille = (int)(1000.0 * (below + per_score[s] / 2.0) / total + 0.5);
+        printf("%s%d,", s % 16 ? " " : "\n    ", permille);
+        below += per_score[s];
+    }
+    printf("\n};\n\n");
+}
+
+int main() {
+    build_binomials();
+    printf("/* Generated by gen_tables at build time - do not edit */\n\n");
+    printf("#include \"poker_variant.h\"\n\n");
+    
+    printf("const uint16_t variant_colex[HAND_SIZE][WILD_INDEX + 1] = {\n");
+    for (int i = 0; i < HAND_SIZE; i++) {
+        printf("    {");
+        for (int r = 0; r <= WILD_INDEX; r++) {
+            printf("%s%d", r ? ", " : "", colex[i][r]);
+        }
+        printf("}%s\n", i + 1 < HAND_SIZE ? "," : "");
+    }
+    printf("};\n\n");
+    
+    for (int v = 0; v < NUM_VARIANTS; v++) {
+        generate(&variants[v]);
+    }
+    
+    printf("const VariantTables variant_tables[NUM_VARIANTS] = {\n");
+    for (int v = 0; v < NUM_VARIANTS; v++) {
+        const char* key = variants[v].key;
+        printf("    {variant_%s_ranks, variant_%s_flush, variant_%s_beats}%s\n", key, key, key,
+               v + 1 < NUM_VARIANTS ? "," : "");
+    }
+    printf("};\n");
+    return 0;
+}
@@ -0,0 +1,256 @@
+/*
+ * Poker Core - computer opponent
+ *
+ * Hands are scored as rank * 100 plus a little for the top card, so a pair
+ * of twos (108) beats ace high (56) and a pair of jacks sits near 144.
+ * Opponent stats move the bet and call lines; with no stats (opp NULL or
+ * too few hands seen) the AI plays straightforward value poker. Other
+ * variants place the hand on the same scale by the share of hands it beats.
+ */
+
+#include "poker_ai.h"
+#include <string.h>
+#include "poker_variant.h"
+#include "trace.h"
+
+#define BET_LINE 150     /* Bet a pair of queens or better */
+#define CALL_LINE 100    /* Call with any pair */
+
+/* Share of the 2,598,960 five-card hands in each class, and below it */
+static const double class_share[] = {
+    0.501177, 0.422569, 0.047539, 0.021128, 0.003925, 0.001965, 0.001441, 0.000240, 0.000015
+};
+static const double class_below[] = {
+    0.0, 0.501177, 0.923746, 0.971285, 0.992414, 0.996339, 0.998304, 0.999745, 0.999985
+};
+
+/* Chance a made hand beats a random one, placing it within its class by its top rank */
+static double showdown_odds(HandEval e) {
+    double within = (e.high_value - TWO) / (double)(ACE - TWO);
+    return class_below[e.rank] + class_share[e.rank] * within;
+}
+
+/* Rough strength of a made hand */
+static int hand_strength(HandEval e) {
+    return e.rank * 100 + e.high_value * 4;
+}
+
+/* Strength of a seat's hand in any variant - high draw scores it directly */
+static int seat_strength(const PokerGame* g, Seat seat) {
+    if (g->rules.variant == VARIANT_DRAW_HIGH) return hand_strength(evaluate_hand(g->hands[seat]));
+    
+    /* Find where the same share of high hands would sit */
+    double beats = variant_evaluate(g->rules.variant, g->hands[seat]).strength / 1000.0;
+    int c = STRAIGHT_FLUSH;
+    while (c > HIGH_CARD && beats < class_below[c]) c--;
+    double within = (beats - class_below[c]) / class_share[c];
+    if (within > 1.0) within = 1.0;
+    return c * 100 + (int)(within * (ACE - TWO) * 4) + TWO * 4;
+}
+
+/* Chance the seat's hand beats a random one */
+static double seat_odds(const PokerGame* g, Seat seat) {
+    if (g->rules.variant == VARIANT_DRAW_HIGH) return showdown_odds(evaluate_hand(g->hands[seat]));
+    return variant_evaluate(g->rules.variant, g->hands[seat]).strength / 1000.0;
+}
+
+/* Check, bet, call or fold - always legal for the current state */
+Action ai_choose_action(PokerGame* g, Seat seat, const OpponentStats* opp) {
+    TRACE_SCOPE("ai_choose_action");
+    Seat other = seat == SEAT_PLAYER ? SEAT_AI : SEAT_PLAYER;
+    int strength = seat_strength(g, seat);
+    int bet_line = BET_LINE;
+    int call_line = CALL_LINE;
+    int bluff = 0;
+    
+    if (opp) {
+        /* Someone who opens the betting with most hands is often betting air; someone who rarely opens means it */
+        int opens = stats_rate(opp->open_bet);
+        if (opens > 600) call_line -= 50;
+        else if (opens >= 0 && opens < 250) call_line += 100;
+        
+        /* A check from someone usually aggressive on this street is a weak check */
+        int street = g->street < STATS_STREETS ? g->street : STATS_STREETS - 1;
+        if (stats_rate(opp->aggression[street]) > 500) bet_line -= 50;
+        
+        /* Bluff in proportion to how often they give up to a bet */
+        int folds = stats_rate(opp->fold_to_bet);
+        if (folds > 400 && rng_range(&g->rng, 1000) < folds - 400) bluff = 1;
+        
+        /* After the draw, what they usually show for this many cards sets a floor (high hands only) */
+        int expected = g->rules.variant == VARIANT_DRAW_HIGH ? stats_expected_rank(opp, g->drawn[other]) : -1;
+        if (expected >= 0) {
+            call_line = (call_line + expected * 100 / STATS_ONE) / 2;
+        }
+    }
+    
+    if (g->to_call > 0) {
+        /* A rare loose call keeps the fold line from being exact */
+        if (strength >= call_line || rng_range(&g->rng, 10) == 0) return ACTION_CALL;
+        return ACTION_FOLD;
+    }
+    
+    if ((strength >= bet_line || bluff) && g->chips[seat] >= g->rules.bet_size) return ACTION_BET;
+    return ACTION_CHECK;
+}
+
+/* The seat's prize equity if the stacks at this table end the hand as given */
+static double seat_equity(const IcmSpot* spot, Seat seat, int mine, int theirs) {
+    int stacks[ICM_MAX_PLAYERS];
+    double equity[ICM_MAX_PLAYERS];
+    memcpy(stacks, spot->stacks, spot->players * sizeof(int));
+    stacks[spot->index[seat]] = mine;
+    stacks[spot->index[seat == SEAT_PLAYER ? SEAT_AI : SEAT_PLAYER]] = theirs;
+    icm_equity(spot->icm, stacks, spot->players, equity);
+    return equity[spot->index[seat]];
+}
+
+/*
+ * Tournament play: as ai_choose_action, except that facing a bet the
+ * call/fold choice is made on prize equity. Folding hands the pot over;
+ * calling is treated as going to showdown at once, won with the odds of
+ * the current hand against a random one. Chips lost near the bubble cost
+ * more than chips won are worth, so this folds hands a cash game would call.
+ */
+Action ai_choose_tournament_action(PokerGame* g, Seat seat, const OpponentStats* opp, const IcmSpot* spot) {
+    TRACE_SCOPE("ai_choose_tournament_action");
+    Action action = ai_choose_action(g, seat, opp);
+    if (!spot || !spot->icm || g->to_call == 0) return action;
+    
+    Seat other = seat == SEAT_PLAYER ? SEAT_AI : SEAT_PLAYER;
+    int call = g->to_call < g->chips[seat] ? g->to_call : g->chips[seat];
+    int refund = g->to_call - call;
+    int pot = g->pot + call - refund;
+    int mine = g->chips[seat] - call;
+    int theirs = g->chips[other] + refund;
+    
+    double win = seat_odds(g, seat);
+    double fold_ev = seat_equity(spot, seat, g->chips[seat], g->chips[other] + g->pot);
+    double call_ev = win * seat_equity(spot, seat, mine + pot, theirs) +
+                     (1.0 - win) * seat_equity(spot, seat, mine, theirs + pot);
+    return call_ev >= fold_ev ? ACTION_CALL : ACTION_FOLD;
+}
+
+/* Lowball: keep one card of each rank up to an eight, throwing pairs and big cards */
+static unsigned int lowball_discards(const PokerGame* g, Seat seat) {
+    const Card* hand = g->hands[seat];
+    int ace_low = g->rules.variant == VARIANT_ACE_TO_FIVE;
+    unsigned int mask = 0;
+    int seen = 0;
+    int top = 0, top_value = 0;
+    for (int i = 0; i < HAND_SIZE; i++) {
+        int value = (ace_low && hand[i].rank == ACE) ? 1 : (int)hand[i].rank;
+        if (value > EIGHT || (seen & (1 << value))) {
+            mask |= 1u << i;
+            continue;
+        }
+        seen |= 1 << value;
+        if (value > top_value) {
+            top = i;
+            top_value = value;
+        }
+    }
+    
+    /* A 2-7 hand that has made a straight or flush breaks it with its top card */
+    if (mask == 0 && !ace_low && variant_evaluate(g->rules.variant, hand).rank != HIGH_CARD) {
+        mask = 1u << top;
+    }
+    return mask;
+}
+
+/* Wild games: stand on a straight or better, else keep the wilds and any paired naturals */
+static unsigned int wild_discards(const PokerGame* g, Seat seat) {
+    const Card* hand = g->hands[seat];
+    if (variant_evaluate(g->rules.variant, hand).rank >= STRAIGHT) return 0;
+    
+    int counts[13] = {0};
+    int top = -1;
+    for (int i = 0; i < HAND_SIZE; i++) {
+        if (variant_is_wild(g->rules.variant, hand[i])) continue;
+        counts[hand[i].rank - 2]++;
+        if (top < 0 || hand[i].rank > hand[top].rank) top = i;
+    }
+    
+    unsigned int keep = 0;
+    int paired = 0;
+    for (int i = 0; i < HAND_SIZE; i++) {
+        if (variant_is_wild(g->rules.variant, hand[i])) {
+            keep |= 1u << i;
+        } else if (counts[hand[i].rank - 2] > 1) {
+            keep |= 1u << i;
+            paired = 1;
+        }
+    }
+    
+    /* Nothing paired - the top card is the one a wild pairs best */
+    if (!paired && top >= 0) keep |= 1u << top;
+    return ~keep & ((1u << HAND_SIZE) - 1);
+}
+
+/*
+ * Cards to throw, as a poker_draw mask. Made hands keep their groups,
+ * four to a flush or an open straight draw the fifth, and anything else
+ * keeps its high cards. Against a player who folds to bets too often a
+ * busted hand is sometimes stood pat on to represent a made one.
+ */
+unsigned int ai_choose_discards(PokerGame* g, Seat seat, const OpponentStats* opp) {
+    TRACE_SCOPE("ai_choose_discards");
+    const VariantInfo* info = variant_info(g->rules.variant);
+    if (info->rule != RULE_HIGH) return lowball_discards(g, seat);
+    if (info->wild) return wild_discards(g, seat);
+    
+    const Card* hand = g->hands[seat];
+    HandEval e = evaluate_hand(hand);
+    
+    if (e.rank >= STRAIGHT) return 0;
+    
+    int counts[13] = {0};
+    int suits[4] = {0};
+    for (int i = 0; i < HAND_SIZE; i++) {
+        counts[hand[i].rank - 2]++;
+        suits[hand[i].suit]++;
+    }
+    
+    unsigned int mask = 0;
+    if (e.rank != HIGH_CARD) {
+        /* Keep every paired rank, throw the singletons */
+        for (int i = 0; i < HAND_SIZE; i++) {
+            if (counts[hand[i].rank - 2] == 1) mask |= 1u << i;
+        }
+        return mask;
+    }
+    
+    /* Four to a flush */
+    for (int s = 0; s < 4; s++) {
+        if (suits[s] != 4) continue;
+        for (int i = 0; i < HAND_SIZE; i++) {
+            if ((int)hand[i].suit != s) mask |= 1u << i;
+        }
+        return mask;
+    }
+    
+    /* Four ranks in a row - throw the odd one */
+    for (int low = 0; low + 3 < 13; low++) {
+        if (!counts[low] || !counts[low + 1] || !counts[low + 2] || !counts[low + 3]) continue;
+        for (int i = 0; i < HAND_SIZE; i++) {
+            int r = hand[i].rank - 2;
+            if (r < low || r > low + 3) mask |= 1u << i;
+        }
+        return mask;
+    }
+    
+    if (opp && stats_rate(opp->fold_to_bet) > 600 && rng_range(&g->rng, 4) == 0) return 0;
+    
+    /* Nothing to draw to - keep up to two cards jack or better, else just the top card */
+    unsigned int keep = 0;
+    int kept = 0;
+    for (int r = ACE; r >= TWO && kept < 2; r--) {
+        for (int i = 0; i < HAND_SIZE && kept < 2; i++) {
+            if ((int)hand[i].rank != r) continue;
+            if (r < JACK && kept > 0) break;
+            keep |= 1u << i;
+            kept++;
+        }
+    }
+    return ~keep & ((1u << HAND_SIZE) - 1);
+}
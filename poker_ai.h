@@ -0,0 +1,18 @@
+/*
+ * Poker Core - computer opponent
+ * Betting and draw choices for a seat, shaded by the running statistics
+ * kept on whoever sits across the table. Every read is O(1).
+ */
+
+#ifndef POKER_AI_H
+#define POKER_AI_H
+
+#include "poker_core.h"
+#include "poker_stats.h"
+#include "poker_icm.h"
+
+Action ai_choose_action(PokerGame* g, Seat seat, const OpponentStats* opp);
+Action ai_choose_tournament_action(PokerGame* g, Seat seat, const OpponentStats* opp, const IcmSpot* spot);
+unsigned int ai_choose_discards(PokerGame* g, Seat seat, const OpponentStats* opp);
+
+#endif
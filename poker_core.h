@@ -0,0 +1,194 @@
+/*
+ * Poker Core - renderer-agnostic five-card draw engine
+ * Deck, RNG, hand evaluator and round state machine shared by
+ * sdl_poker.c, raylib_poker.c and the headless tools.
+ * No graphics dependency; built as libpokercore (static and shared).
+ */
+
+#ifndef POKER_CORE_H
+#define POKER_CORE_H
+
+#include <stdint.h>
+
+#define DECK_SIZE 52
+#define MAX_DECKS 8
+#define MAX_JOKERS 2
+#define DECK_MAX (DECK_SIZE * MAX_DECKS + MAX_JOKERS)
+#define HAND_SIZE 5
+#define NUM_SEATS 2
+
+/* Card Suits and Ranks */
+typedef enum {
+    HEARTS, DIAMONDS, CLUBS, SPADES
+} Suit;
+
+typedef enum {
+    TWO = 2, THREE, FOUR, FIVE, SIX, SEVEN, EIGHT, NINE, TEN, JACK, QUEEN, KING, ACE,
+    JOKER              /* Only dealt in joker games; its suit means nothing */
+} Rank;
+
+/* Hand Rankings */
+typedef enum {
+    HIGH_CARD,
+    PAIR,
+    TWO_PAIR,
+    THREE_OF_KIND,
+    STRAIGHT,
+    FLUSH,
+    FULL_HOUSE,
+    FOUR_OF_KIND,
+    STRAIGHT_FLUSH,
+    FIVE_OF_KIND       /* Wild card games only */
+} HandRank;
+
+/* Games the table can play - see poker_variant.h */
+typedef enum {
+    VARIANT_DRAW_HIGH,       /* Five-card draw, high hand wins */
+    VARIANT_DEUCE_TO_SEVEN,  /* 2-7 triple draw lowball */
+    VARIANT_ACE_TO_FIVE,     /* A-5 lowball */
+    VARIANT_DEUCES_WILD,     /* Five-card draw with every two wild */
+    VARIANT_JOKER_WILD,      /* Five-card draw with one wild joker in the deck */
+    NUM_VARIANTS
+} Variant;
+
+/* Game States for State Machine */
+typedef enum {
+    START_ROUND,
+    PLAYER_TURN,
+    AI_TURN,
+    PLAYER_DRAW,
+    AI_DRAW,
+    SHOWDOWN,
+    ROUND_END,
+    GAME_OVER
+} GameState;
+
+/* Seats at the table - the player always acts first */
+typedef enum {
+    SEAT_PLAYER,
+    SEAT_AI
+} Seat;
+
+/* Betting actions */
+typedef enum {
+    ACTION_CHECK,
+    ACTION_BET,
+    ACTION_CALL,
+    ACTION_FOLD
+} Action;
+
+/* Things the state machine reports to an observer */
+typedef enum {
+    EVENT_ROUND_START,
+    EVENT_ACTION,
+    EVENT_DRAW,
+    EVENT_SHOWDOWN,
+    EVENT_ROUND_END,
+    EVENT_STATE
+} PokerEventType;
+
+/* Card Structure */
+typedef struct {
+    Suit suit;
+    Rank rank;
+} Card;
+
+/* Random number generator - xorshift64*, one per game so simulations can run in parallel */
+typedef struct {
+    uint64_t state;
+} PokerRng;
+
+/* Deck Structure - a shoe of one or more 52-card decks, plus any jokers the variant adds */
+typedef struct {
+    Card cards[DECK_MAX];
+    uint16_t swaps[DECK_MAX];   /* Where each dealt position's card was swapped in from, for reset_deck */
+    int size;
+    int top;                    /* Cards dealt since the last reset */
+    int decks;
+    int jokers;
+} Deck;
+
+/* Hand Evaluation Result */
+typedef struct {
+    HandRank rank;
+    int high_value;   /* Rank of the leading group or top card, for display */
+    int score;        /* Rank and all kickers packed - higher score wins */
+    int strength;     /* Permille of the variant's hands this one beats (variant_evaluate only) */
+} HandEval;
+
+/*
+ * One state machine event - fields not used by the event type are zero.
+ * An event that changes state is followed by the EVENT_STATE it caused.
+ */
+typedef struct {
+    PokerEventType type;
+    int seat;            /* Acting seat (EVENT_STATE: seat to act next); EVENT_ROUND_END: winner, -1 for a split */
+    Action action;       /* EVENT_ACTION */
+    int amount;          /* EVENT_ACTION: chips put in the pot */
+    int facing_bet;      /* EVENT_ACTION: the seat acted into an outstanding bet */
+    int street;          /* Betting round the event happened in */
+    int cards;           /* EVENT_DRAW: cards replaced */
+    HandRank hand_rank;  /* EVENT_SHOWDOWN: the hand the seat showed */
+    GameState prev_state;  /* EVENT_STATE: the state just left */
+    GameState state;     /* State once the event happened */
+} PokerEvent;
+
+typedef void (*PokerEventFn)(void* ctx, const PokerEvent* ev);
+
+/* Table rules */
+typedef struct {
+    int starting_chips;
+    int ante;
+    int bet_size;
+    int draw_rounds;   /* 0 plays a single betting round straight to showdown */
+    Variant variant;   /* Which hands win, and whether jokers go in the deck */
+} PokerRules;
+
+/* One heads-up table: chips, hands and where the round is */
+typedef struct {
+    PokerRules rules;
+    PokerRng rng;
+    Deck deck;
+    Card hands[NUM_SEATS][HAND_SIZE];
+    int chips[NUM_SEATS];
+    int pot;
+    int to_call;       /* Outstanding bet the acting seat faces */
+    int street;        /* Betting rounds completed this hand */
+    GameState state;
+    int revealed;      /* Hands were shown down this round */
+    int winner;        /* Seat that took the last pot, -1 for a split */
+    int drawn[NUM_SEATS];   /* Cards each seat drew this hand, -1 before it draws */
+    HandEval evals[NUM_SEATS];
+    PokerEventFn on_event;  /* Optional observer, called synchronously */
+    void* event_ctx;
+} PokerGame;
+
+/* RNG */
+void rng_seed(PokerRng* rng, uint64_t seed);
+uint32_t rng_next(PokerRng* rng);
+int rng_range(PokerRng* rng, int n);
+
+/* Deck */
+void init_deck(Deck* d, int decks, int jokers);
+void reset_deck(Deck* d);
+int deal_card(Deck* d, PokerRng* rng, Card* out);
+int cards_left(const Deck* d);
+
+/* Evaluation */
+const char* suit_to_string(Suit s);
+const char* rank_to_string(Rank r);
+const char* hand_rank_to_string(HandRank r);
+int compare_cards(const void* a, const void* b);
+HandEval evaluate_hand(const Card* hand);
+int compare_hands(HandEval h1, HandEval h2);
+
+/* State machine */
+void poker_game_init(PokerGame* g, const PokerRules* rules, uint64_t seed);
+void poker_set_observer(PokerGame* g, PokerEventFn fn, void* ctx);
+int poker_start_round(PokerGame* g);
+Seat poker_acting_seat(const PokerGame* g);
+int poker_act(PokerGame* g, Seat seat, Action action);
+int poker_draw(PokerGame* g, Seat seat, unsigned int discard_mask);
+void poker_showdown(PokerGame* g);
+
+#endif
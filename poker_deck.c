@@ -0,0 +1,70 @@
+/*
+ * Poker Core - deck management
+ *
+ * The deck is shuffled lazily: each deal swaps a random undealt card into
+ * the next position (one step of Fisher-Yates), so a hand only pays for
+ * the cards it actually uses. Every swap is written to an undo list, and
+ * reset_deck() plays the list backwards to put the shoe back in its
+ * built order, so each hand's deal depends on the RNG alone.
+ */
+
+#include "poker_core.h"
+#include "trace.h"
+
+/* Build a shoe of `decks` 52-card decks plus any jokers, in suit-then-rank order */
+void init_deck(Deck* d, int decks, int jokers) {
+    if (decks < 1) decks = 1;
+    if (decks > MAX_DECKS) decks = MAX_DECKS;
+    if (jokers < 0) jokers = 0;
+    if (jokers > MAX_JOKERS) jokers = MAX_JOKERS;
+    
+    int index = 0;
+    for (int deck = 0; deck < decks; deck++) {
+        for (int suit = HEARTS; suit <= SPADES; suit++) {
+            for (int rank = TWO; rank <= ACE; rank++) {
+                d->cards[index].suit = suit;
+                d->cards[index].rank = rank;
+                index++;
+            }
+        }
+    }
+    for (int i = 0; i < jokers; i++) {
+        d->cards[index].suit = SPADES;
+        d->cards[index].rank = JOKER;
+        index++;
+    }
+    d->size = index;
+    d->top = 0;
+    d->decks = decks;
+    d->jokers = jokers;
+}
+
+/* Undo this hand's swaps, newest first - costs one swap per card dealt */
+void reset_deck(Deck* d) {
+    TRACE_SCOPE("reset_deck");
+    while (d->top > 0) {
+        d->top--;
+        int j = d->swaps[d->top];
+        Card temp = d->cards[d->top];
+        d->cards[d->top] = d->cards[j];
+        d->cards[j] = temp;
+    }
+}
+
+/* Deal a random undealt card - returns 0 (leaving *out untouched) once the shoe is exhausted */
+int deal_card(Deck* d, PokerRng* rng, Card* out) {
+    if (d->top >= d->size) return 0;
+    
+    int j = d->top + rng_range(rng, d->size - d->top);
+    Card temp = d->cards[d->top];
+    d->cards[d->top] = d->cards[j];
+    d->cards[j] = temp;
+    d->swaps[d->top] = (uint16_t)j;
+    *out = d->cards[d->top++];
+    return 1;
+}
+
+/* Cards still to come before the shoe runs out */
+int cards_left(const Deck* d) {
+    return d->size - d->top;
+}
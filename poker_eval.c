@@ -0,0 +1,144 @@
+/*
+ * Poker Core - hand evaluation
+ */
+
+#include "poker_core.h"
+#include "trace.h"
+
+/* Ranks present in the wheel straight A-2-3-4-5, as a bitmask indexed by rank - 2 */
+#define WHEEL_MASK 0x100F
+
+/* Card suit/rank to string helpers */
+const char* suit_to_string(Suit s) {
+    switch(s) {
+        case HEARTS: return "H";
+        case DIAMONDS: return "D";
+        case CLUBS: return "C";
+        case SPADES: return "S";
+        default: return "?";
+    }
+}
+
+const char* rank_to_string(Rank r) {
+    switch(r) {
+        case TWO: return "2";
+        case THREE: return "3";
+        case FOUR: return "4";
+        case FIVE: return "5";
+        case SIX: return "6";
+        case SEVEN: return "7";
+        case EIGHT: return "8";
+        case NINE: return "9";
+        case TEN: return "10";
+        case JACK: return "J";
+        case QUEEN: return "Q";
+        case KING: return "K";
+        case ACE: return "A";
+        case JOKER: return "Jk";
+        default: return "?";
+    }
+}
+
+const char* hand_rank_to_string(HandRank r) {
+    switch(r) {
+        case HIGH_CARD: return "High Card";
+        case PAIR: return "Pair";
+        case TWO_PAIR: return "Two Pair";
+        case THREE_OF_KIND: return "Three of a Kind";
+        case STRAIGHT: return "Straight";
+        case FLUSH: return "Flush";
+        case FULL_HOUSE: return "Full House";
+        case FOUR_OF_KIND: return "Four of a Kind";
+        case STRAIGHT_FLUSH: return "Straight Flush";
+        case FIVE_OF_KIND: return "Five of a Kind";
+        default: return "?";
+    }
+}
+
+/* Comparison function for qsort - sorts by rank */
+int compare_cards(const void* a, const void* b) {
+    const Card* card_a = (const Card*)a;
+    const Card* card_b = (const Card*)b;
+    return card_a->rank - card_b->rank;
+}
+
+/*
+ * Evaluate hand using rank counting - ranks are ordered into kickers by
+ * group size then rank (e.g. 9-9-9-3-3 gives 9,3), and the kickers are
+ * packed under the hand rank so one integer compare settles any showdown.
+ */
+HandEval evaluate_hand(const Card* hand) {
+    TRACE_SCOPE("evaluate_hand");
+    HandEval result = {HIGH_CARD, 0, 0, 0};
+    
+    /* Count ranks using counting algorithm */
+    int counts[13] = {0};
+    unsigned int rank_mask = 0;
+    int flush = 1;
+    for (int i = 0; i < HAND_SIZE; i++) {
+        counts[hand[i].rank - 2]++;
+        rank_mask |= 1u << (hand[i].rank - 2);
+        if (hand[i].suit != hand[0].suit) flush = 0;
+    }
+    
+    int kickers[HAND_SIZE] = {0};
+    int groups = 0;
+    for (int size = 4; size >= 1; size--) {
+        for (int r = 12; r >= 0; r--) {
+            if (counts[r] == size) kickers[groups++] = r + 2;
+        }
+    }
+    
+    int top = counts[kickers[0] - 2];
+    int second = groups > 1 ? counts[kickers[1] - 2] : 0;
+    int straight = 0;
+    if (groups == HAND_SIZE) {
+        if (kickers[0] - kickers[4] == 4) {
+            straight = 1;
+        } else if (rank_mask == WHEEL_MASK) {
+            /* Ace plays low: 5-4-3-2-A */
+            straight = 1;
+            kickers[0] = FIVE;
+            kickers[1] = FOUR;
+            kickers[2] = THREE;
+            kickers[3] = TWO;
+            kickers[4] = 1;
+        }
+    }
+    
+    /* Determine hand rank */
+    if (straight && flush) {
+        result.rank = STRAIGHT_FLUSH;
+    } else if (top == 4) {
+        result.rank = FOUR_OF_KIND;
+    } else if (top == 3 && second == 2) {
+        result.rank = FULL_HOUSE;
+    } else if (flush) {
+        result.rank = FLUSH;
+    } else if (straight) {
+        result.rank = STRAIGHT;
+    } else if (top == 3) {
+        result.rank = THREE_OF_KIND;
+    } else if (top == 2 && second == 2) {
+        result.rank = TWO_PAIR;
+    } else if (top == 2) {
+        result.rank = PAIR;
+    } else {
+        result.rank = HIGH_CARD;
+    }
+    
+    result.high_value = kickers[0];
+    result.score = result.rank;
+    for (int i = 0; i < HAND_SIZE; i++) {
+        result.score = (result.score << 4) | kickers[i];
+    }
+    
+    return result;
+}
+
+/* Compare two hands - returns 1 if h1 wins, -1 if h2 wins, 0 for tie */
+int compare_hands(HandEval h1, HandEval h2) {
+    if (h1.score > h2.score) return 1;
+    if (h1.score < h2.score) return -1;
+    return 0;
+}
@@ -0,0 +1,222 @@
+/*
+ * Poker Core - round state machine
+ *
+ * START_ROUND -> PLAYER_TURN <-> AI_TURN -> (PLAYER_DRAW -> AI_DRAW ->
+ * PLAYER_TURN ...) -> SHOWDOWN -> ROUND_END, with a fold ending the round
+ * at any turn and GAME_OVER once someone cannot pay the ante.
+ */
+
+#include "poker_core.h"
+#include <string.h>
+#include "poker_variant.h"
+#include "trace.h"
+
+/* The seat that isn't this one */
+static Seat other_seat(Seat seat) {
+    return seat == SEAT_PLAYER ? SEAT_AI : SEAT_PLAYER;
+}
+
+/* Tell the observer, if any, what just happened */
+static void emit(PokerGame* g, PokerEvent* ev) {
+    if (!g->on_event) return;
+    ev->street = g->street;
+    ev->state = g->state;
+    g->on_event(g->event_ctx, ev);
+}
+
+/* Every state change goes through here, so observers see each transition */
+static void set_state(PokerGame* g, GameState state) {
+    PokerEvent ev = {.type = EVENT_STATE, .prev_state = g->state};
+    g->state = state;
+    ev.seat = poker_acting_seat(g);
+    emit(g, &ev);
+}
+
+/* Betting round over - move on to the next draw, or to showdown after the last */
+static void end_street(PokerGame* g) {
+    g->to_call = 0;
+    int last = g->street >= g->rules.draw_rounds;
+    g->street++;
+    set_state(g, last ? SHOWDOWN : PLAYER_DRAW);
+}
+
+/* Give the whole pot to one seat */
+static void award_pot(PokerGame* g, Seat seat) {
+    g->chips[seat] += g->pot;
+    g->pot = 0;
+    g->winner = seat;
+    
+    PokerEvent ev = {.type = EVENT_ROUND_END, .seat = seat};
+    emit(g, &ev);
+    set_state(g, ROUND_END);
+}
+
+/* Set up a table with both stacks full, waiting for the first round */
+void poker_game_init(PokerGame* g, const PokerRules* rules, uint64_t seed) {
+    memset(g, 0, sizeof(*g));
+    g->rules = *rules;
+    rng_seed(&g->rng, seed);
+    g->chips[SEAT_PLAYER] = rules->starting_chips;
+    g->chips[SEAT_AI] = rules->starting_chips;
+    g->state = START_ROUND;
+    g->winner = -1;
+}
+
+/* Register a callback for every action, draw, showdown and round boundary */
+void poker_set_observer(PokerGame* g, PokerEventFn fn, void* ctx) {
+    g->on_event = fn;
+    g->event_ctx = ctx;
+}
+
+/* Ante, shuffle and deal - returns 0 (and ends the game) if someone can't pay the ante */
+int poker_start_round(PokerGame* g) {
+    TRACE_SCOPE("poker_start_round");
+    g->pot = 0;
+    g->to_call = 0;
+    g->street = 0;
+    g->revealed = 0;
+    g->winner = -1;
+    g->drawn[SEAT_PLAYER] = g->drawn[SEAT_AI] = -1;
+    
+    if (g->chips[SEAT_PLAYER] < g->rules.ante || g->chips[SEAT_AI] < g->rules.ante) {
+        set_state(g, GAME_OVER);
+        return 0;
+    }
+    
+    /* Ante */
+    g->chips[SEAT_PLAYER] -= g->rules.ante;
+    g->chips[SEAT_AI] -= g->rules.ante;
+    g->pot = 2 * g->rules.ante;
+    
+    /* Rebuild the deck only when the variant changes what's in it - otherwise just undo the last deal */
+    int jokers = variant_info(g->rules.variant)->jokers;
+    if (g->deck.size == 0 || g->deck.jokers != jokers) {
+        init_deck(&g->deck, 1, jokers);
+    } else {
+        reset_deck(&g->deck);
+    }
+    
+    /* Deal alternately, shuffling as we go */
+    for (int i = 0; i < HAND_SIZE; i++) {
+        deal_card(&g->deck, &g->rng, &g->hands[SEAT_PLAYER][i]);
+        deal_card(&g->deck, &g->rng, &g->hands[SEAT_AI][i]);
+    }
+    
+    PokerEvent ev = {.type = EVENT_ROUND_START, .seat = SEAT_PLAYER};
+    emit(g, &ev);
+    set_state(g, PLAYER_TURN);
+    return 1;
+}
+
+/* Seat whose turn it is to bet or draw */
+Seat poker_acting_seat(const PokerGame* g) {
+    return (g->state == AI_TURN || g->state == AI_DRAW) ? SEAT_AI : SEAT_PLAYER;
+}
+
+/* Apply a betting action - returns 0 if it isn't this seat's turn or the action isn't legal */
+int poker_act(PokerGame* g, Seat seat, Action action) {
+    if (g->state != PLAYER_TURN && g->state != AI_TURN) return 0;
+    if (seat != poker_acting_seat(g)) return 0;
+    
+    Seat other = other_seat(seat);
+    GameState other_turn = seat == SEAT_PLAYER ? AI_TURN : PLAYER_TURN;
+    PokerEvent ev = {.type = EVENT_ACTION, .seat = seat, .action = action};
+    ev.facing_bet = g->to_call > 0;
+    
+    switch (action) {
+        case ACTION_CHECK:
+            if (g->to_call > 0) return 0;
+            /* The player opens each street, so a check from the AI closes it */
+            emit(g, &ev);
+            if (seat == SEAT_PLAYER) {
+                set_state(g, other_turn);
+            } else {
+                end_street(g);
+            }
+            return 1;
+        
+        case ACTION_BET:
+            if (g->to_call > 0 || g->chips[seat] < g->rules.bet_size) return 0;
+            g->chips[seat] -= g->rules.bet_size;
+            g->pot += g->rules.bet_size;
+            g->to_call = g->rules.bet_size;
+            ev.amount = g->rules.bet_size;
+            emit(g, &ev);
+            set_state(g, other_turn);
+            return 1;
+        
+        case ACTION_CALL: {
+            if (g->to_call == 0) return 0;
+            /* A short stack calls all-in and the uncalled part goes back */
+            int amount = g->chips[seat] < g->to_call ? g->chips[seat] : g->to_call;
+            int refund = g->to_call - amount;
+            g->chips[seat] -= amount;
+            g->chips[other] += refund;
+            g->pot += amount - refund;
+            ev.amount = amount;
+            emit(g, &ev);
+            end_street(g);
+            return 1;
+        }
+        
+        case ACTION_FOLD:
+            emit(g, &ev);
+            award_pot(g, other);
+            return 1;
+    }
+    return 0;
+}
+
+/* Replace the cards set in discard_mask (bit i = card i) - returns how many were replaced, fewer if the deck ran out */
+int poker_draw(PokerGame* g, Seat seat, unsigned int discard_mask) {
+    if (g->state != PLAYER_DRAW && g->state != AI_DRAW) return 0;
+    if (seat != poker_acting_seat(g)) return 0;
+    
+    int replaced = 0;
+    for (int i = 0; i < HAND_SIZE; i++) {
+        if ((discard_mask & (1u << i)) && deal_card(&g->deck, &g->rng, &g->hands[seat][i])) {
+            replaced++;
+        }
+    }
+    
+    g->drawn[seat] = replaced;
+    
+    PokerEvent ev = {.type = EVENT_DRAW, .seat = seat};
+    ev.cards = replaced;
+    emit(g, &ev);
+    set_state(g, seat == SEAT_PLAYER ? AI_DRAW : PLAYER_TURN);
+    return replaced;
+}
+
+/* Showdown - reveal hands and determine winner */
+void poker_showdown(PokerGame* g) {
+    TRACE_SCOPE("poker_showdown");
+    if (g->state != SHOWDOWN) return;
+    
+    g->revealed = 1;
+    g->evals[SEAT_PLAYER] = variant_evaluate(g->rules.variant, g->hands[SEAT_PLAYER]);
+    g->evals[SEAT_AI] = variant_evaluate(g->rules.variant, g->hands[SEAT_AI]);
+    
+    for (int seat = SEAT_PLAYER; seat <= SEAT_AI; seat++) {
+        PokerEvent ev = {.type = EVENT_SHOWDOWN, .seat = seat};
+        ev.hand_rank = g->evals[seat].rank;
+        emit(g, &ev);
+    }
+    
+    int result = compare_hands(g->evals[SEAT_PLAYER], g->evals[SEAT_AI]);
+    if (result > 0) {
+        award_pot(g, SEAT_PLAYER);
+    } else if (result < 0) {
+        award_pot(g, SEAT_AI);
+    } else {
+        /* Split - an odd chip stays in front of the player */
+        g->chips[SEAT_AI] += g->pot / 2;
+        g->chips[SEAT_PLAYER] += g->pot - g->pot / 2;
+        g->pot = 0;
+        g->winner = -1;
+        
+        PokerEvent ev = {.type = EVENT_ROUND_END, .seat = -1};
+        emit(g, &ev);
+        set_state(g, ROUND_END);
+    }
+}
@@ -0,0 +1,208 @@
+/*
+ * Poker Core - Independent Chip Model
+ *
+ * P(S) is the chance that exactly the players in S took places 1..|S|,
+ * in some order. From a state S the next place goes to j with probability
+ * stack[j] / (chips outside S), which pays j payouts[|S|] and moves
+ * P(S) * that into P(S + j). Each layer holds every subset of one size,
+ * indexed by its colex rank, so merging paths needs no hashing.
+ */
+
+#include "poker_icm.h"
+#include <stdlib.h>
+#include <string.h>
+#include "trace.h"
+
+/* Largest layer kept: C(ICM_MAX_PLAYERS, ICM_MAX_PAID - 2) = C(20, 4), the last place is never stored */
+#define ICM_MAX_LAYER 4845
+
+/* One set of players who took the top places, and how likely that is */
+typedef struct {
+    uint32_t mask;
+    double prob;
+} IcmState;
+
+/* A stack vector we have already solved */
+typedef struct {
+    int used;
+    int n;
+    int stacks[ICM_MAX_PLAYERS];
+    double equity[ICM_MAX_PLAYERS];
+} IcmMemo;
+
+struct IcmWorkspace {
+    double payouts[ICM_MAX_PAID];
+    int paid;
+    uint32_t binom[ICM_MAX_PLAYERS + 1][ICM_MAX_PAID + 1];
+    IcmState layers[2][ICM_MAX_LAYER];
+    IcmMemo memo[ICM_MEMO_SLOTS];
+};
+
+/* FNV-1a over the stack vector, to pick a memo slot */
+static uint32_t stacks_hash(const int* stacks, int n) {
+    uint32_t h = 2166136261u;
+    for (int i = 0; i < n; i++) {
+        h = (h ^ (uint32_t)stacks[i]) * 16777619u;
+    }
+    return h ^ (uint32_t)n;
+}
+
+/* Only empty stacks are left outside mask - they split places k.. evenly */
+static void share_empty(const IcmWorkspace* ws, int n, uint32_t mask, int k, int paid,
+                        double prob, double* equity) {
+    double share = 0.0;
+    for (int p = k; p < paid; p++) share += ws->payouts[p];
+    share /= n - k;
+    for (int j = 0; j < n; j++) {
+        if (!(mask & (1u << j))) equity[j] += prob * share;
+    }
+}
+
+/* Workspace for one payout table - payouts[0] is first place. NULL if out of memory */
+IcmWorkspace* icm_new(const double* payouts, int paid) {
+    IcmWorkspace* ws = calloc(1, sizeof(IcmWorkspace));
+    if (!ws) return NULL;
+    
+    ws->paid = paid < ICM_MAX_PAID ? paid : ICM_MAX_PAID;
+    memcpy(ws->payouts, payouts, ws->paid * sizeof(double));
+    
+    for (int n = 0; n <= ICM_MAX_PLAYERS; n++) {
+        ws->binom[n][0] = 1;
+        for (int k = 1; k <= ICM_MAX_PAID; k++) {
+            ws->binom[n][k] = n == 0 ? 0 : ws->binom[n - 1][k - 1] + ws->binom[n - 1][k];
+        }
+    }
+    return ws;
+}
+
+void icm_free(IcmWorkspace* ws) {
+    free(ws);
+}
+
+/* Prize equity of each of n stacks (n <= ICM_MAX_PLAYERS), in the units of the payout table */
+void icm_equity(IcmWorkspace* ws, const int* stacks, int n, double* equity) {
+    TRACE_SCOPE("icm_equity");
+    IcmMemo* memo = &ws->memo[stacks_hash(stacks, n) % ICM_MEMO_SLOTS];
+    if (memo->used && memo->n == n && memcmp(memo->stacks, stacks, n * sizeof(int)) == 0) {
+        memcpy(equity, memo->equity, n * sizeof(double));
+        return;
+    }
+    
+    int total = 0;
+    for (int i = 0; i < n; i++) {
+        total += stacks[i];
+        equity[i] = 0.0;
+    }
+    
+    int paid = ws->paid < n ? ws->paid : n;
+    IcmState* cur = ws->layers[0];
+    uint32_t cur_count = 1;
+    cur[0].mask = 0;
+    cur[0].prob = 1.0;
+    
+    for (int k = 0; k < paid; k++) {
+        int last = k + 1 == paid;
+        /* Place paid-1 is folded into this pass - its layer would be the biggest */
+        int fold_last = k + 2 == paid;
+        IcmState* next = ws->layers[(k + 1) & 1];
+        uint32_t next_count = last || fold_last ? 0 : ws->binom[n][k + 1];
+        for (uint32_t i = 0; i < next_count; i++) {
+            next[i].prob = 0.0;
+        }
+        
+        /*
+         * j takes place k from S with P(S) * stack[j] / rest(S), so its share
+         * of the place is stack[j] times the sum of P(S) / rest(S) over every
+         * S without j - the sum over all S less the states that hold j.
+         */
+        double weight_all = 0.0;
+        double weight_with[ICM_MAX_PLAYERS] = {0.0};
+        double last_all = 0.0;
+        double last_with[ICM_MAX_PLAYERS] = {0.0};
+        
+        for (uint32_t s = 0; s < cur_count; s++) {
+            uint32_t mask = cur[s].mask;
+            double prob = cur[s].prob;
+            if (prob == 0.0) continue;
+            
+            int rest = total;
+            for (uint32_t m = mask; m; m &= m - 1) {
+                rest -= stacks[__builtin_ctz(m)];
+            }
+            
+            if (rest <= 0) {
+                share_empty(ws, n, mask, k, paid, prob, equity);
+                continue;
+            }
+            
+            double weight = prob / rest;
+            weight_all += weight;
+            for (uint32_t m = mask; m; m &= m - 1) {
+                weight_with[__builtin_ctz(m)] += weight;
+            }
+            if (last) continue;
+            
+            if (fold_last) {
+                /* Same sums for the last place, from S + j, whose rest is rest(S) - stack[j] */
+                double from_state = 0.0;
+                for (int j = 0; j < n; j++) {
+                    if ((mask & (1u << j)) || stacks[j] <= 0) continue;
+                    double p = weight * stacks[j];
+                    if (rest - stacks[j] <= 0) {
+                        share_empty(ws, n, mask | (1u << j), k + 1, paid, p, equity);
+                        continue;
+                    }
+                    double w = p / (rest - stacks[j]);
+                    from_state += w;
+                    last_with[j] += w;
+                }
+                last_all += from_state;
+                for (uint32_t m = mask; m; m &= m - 1) {
+                    last_with[__builtin_ctz(m)] += from_state;
+                }
+                continue;
+            }
+            
+            /*
+             * Colex rank of S + j is sum C(bit, position) over its bits. Walking
+             * j upwards, members below j keep their position in S and members
+             * above move up one, so both halves update in O(1) per step.
+             */
+            uint32_t below = 0, above = 0;
+            int i = 1;
+            for (uint32_t m = mask; m; m &= m - 1, i++) {
+                above += ws->binom[__builtin_ctz(m)][i + 1];
+            }
+            
+            int members_below = 0;
+            for (int j = 0; j < n; j++) {
+                if (mask & (1u << j)) {
+                    members_below++;
+                    below += ws->binom[j][members_below];
+                    above -= ws->binom[j][members_below + 1];
+                    continue;
+                }
+                if (stacks[j] <= 0) continue;
+                IcmState* st = &next[below + ws->binom[j][members_below + 1] + above];
+                st->mask = mask | (1u << j);
+                st->prob += weight * stacks[j];
+            }
+        }
+        
+        for (int j = 0; j < n; j++) {
+            equity[j] += ws->payouts[k] * stacks[j] * (weight_all - weight_with[j]);
+            if (fold_last) {
+                equity[j] += ws->payouts[k + 1] * stacks[j] * (last_all - last_with[j]);
+            }
+        }
+        if (fold_last) break;
+        
+        cur = next;
+        cur_count = next_count;
+    }
+    
+    memo->used = 1;
+    memo->n = n;
+    memcpy(memo->stacks, stacks, n * sizeof(int));
+    memcpy(memo->equity, equity, n * sizeof(double));
+}
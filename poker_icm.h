@@ -0,0 +1,37 @@
+/*
+ * Poker Core - Independent Chip Model
+ * Turns tournament chip stacks into shares of the prize pool
+ * (Malmuth-Harville: a stack finishes first with probability
+ * proportional to its size, then the rest play on for second, and so on).
+ *
+ * Only finishing orders that reach a paid place matter, so the work is a
+ * DP over subsets of at most paid-1 players, one dense layer per subset
+ * size. That keeps 20 stacks with 5 paid places well under a millisecond.
+ * Results for recently seen stack vectors are memoized in the workspace,
+ * which is not shared: give each thread its own.
+ */
+
+#ifndef POKER_ICM_H
+#define POKER_ICM_H
+
+#include "poker_core.h"
+
+#define ICM_MAX_PLAYERS 20
+#define ICM_MAX_PAID 6
+#define ICM_MEMO_SLOTS 64
+
+typedef struct IcmWorkspace IcmWorkspace;
+
+/* A decision at one table, seen in the context of the whole tournament */
+typedef struct {
+    IcmWorkspace* icm;
+    int players;                   /* Stacks still in the tournament */
+    int stacks[ICM_MAX_PLAYERS];   /* Everyone's chips, this table's as they were before the hand */
+    int index[NUM_SEATS];          /* Where each seat at this table sits in stacks */
+} IcmSpot;
+
+IcmWorkspace* icm_new(const double* payouts, int paid);
+void icm_free(IcmWorkspace* ws);
+void icm_equity(IcmWorkspace* ws, const int* stacks, int n, double* equity);
+
+#endif
@@ -0,0 +1,191 @@
+/*
+ * Poker Core - draw odds
+ *
+ * Only a flush cares about suits, so the draw is counted in two passes.
+ * The first walks the rank multisets the replacements can form, one rank
+ * at a time, weighting each by how many card combinations it stands for
+ * (C(cards of that rank left, cards taken) per rank) and classing it with
+ * suits ignored - at most C(17, 5) = 6,188 shapes instead of the
+ * C(47, 5) = 1,533,939 hands of a five-card draw. The second pass walks
+ * the suited draws that could complete a flush and moves them from the
+ * straight or high-card count into the flush classes.
+ */
+
+#include "poker_odds.h"
+#include <string.h>
+#include "trace.h"
+
+/* Ranks present in the wheel straight A-2-3-4-5, as a bitmask indexed by rank - 2 (as in poker_eval.c) */
+#define WHEEL_MASK 0x100F
+
+/* C(n, k) for the at most four cards of a rank */
+static const uint8_t binom4[5][5] = {
+    {1, 0, 0, 0, 0},
+    {1, 1, 0, 0, 0},
+    {1, 2, 1, 0, 0},
+    {1, 3, 3, 1, 0},
+    {1, 4, 6, 4, 1}
+};
+
+void shape_clear(HandShape* s) {
+    memset(s, 0, sizeof(*s));
+}
+
+/* Rank-only halves of add and remove - the rank walk never touches suits */
+static void add_rank(HandShape* s, int r) {
+    s->groups[s->rank_count[r]]--;
+    s->groups[++s->rank_count[r]]++;
+    s->rank_mask |= 1u << r;
+    s->cards++;
+}
+
+static void remove_rank(HandShape* s, int r) {
+    s->groups[s->rank_count[r]]--;
+    s->groups[--s->rank_count[r]]++;
+    if (s->rank_count[r] == 0) s->rank_mask &= ~(1u << r);
+    s->cards--;
+}
+
+void shape_add(HandShape* s, Card c) {
+    add_rank(s, c.rank - TWO);
+    s->suit_ranks[c.suit] |= 1u << (c.rank - TWO);
+}
+
+void shape_remove(HandShape* s, Card c) {
+    remove_rank(s, c.rank - TWO);
+    s->suit_ranks[c.suit] &= ~(1u << (c.rank - TWO));
+}
+
+static int is_straight(unsigned int rank_mask) {
+    unsigned int low = rank_mask & -rank_mask;
+    return rank_mask == low * 0x1F || rank_mask == WHEEL_MASK;
+}
+
+/* Class of a five-card shape - same answer as evaluate_hand().rank */
+HandRank shape_class(const HandShape* s) {
+    if (s->groups[4]) return FOUR_OF_KIND;
+    if (s->groups[3]) return s->groups[2] ? FULL_HOUSE : THREE_OF_KIND;
+    if (s->groups[2]) return s->groups[2] == 2 ? TWO_PAIR : PAIR;
+    
+    /* Five different ranks - a flush has them all in one suit */
+    int straight = is_straight(s->rank_mask);
+    int flush = s->suit_ranks[0] == s->rank_mask || s->suit_ranks[1] == s->rank_mask ||
+                s->suit_ranks[2] == s->rank_mask || s->suit_ranks[3] == s->rank_mask;
+    if (straight && flush) return STRAIGHT_FLUSH;
+    if (flush) return FLUSH;
+    if (straight) return STRAIGHT;
+    return HIGH_CARD;
+}
+
+/* Take `left` more cards from ranks r and up; weight is the card combinations this path covers */
+static void walk_ranks(DrawOdds* o, HandShape* s, int r, int left, uint32_t weight) {
+    if (left == 0) {
+        o->outcomes[shape_class(s)] += weight;
+        return;
+    }
+    if (r == 13) return;
+    
+    walk_ranks(o, s, r + 1, left, weight);
+    int n = o->unseen_count[r];
+    int take = 0;
+    while (take < n && take < left) {
+        add_rank(s, r);
+        take++;
+        walk_ranks(o, s, r + 1, left - take, weight * binom4[n][take]);
+    }
+    while (take--) remove_rank(s, r);
+}
+
+/*
+ * The rank walk counted every draw as unsuited. Draws that finish five
+ * cards of one suit are exactly the held cards' suit (any suit if nothing
+ * is held) filled from that suit's unseen ranks - move each of those to
+ * its flush class.
+ */
+static void count_flushes(DrawOdds* o, int left) {
+    for (int suit = HEARTS; suit <= SPADES; suit++) {
+        if (o->held.suit_ranks[suit] != o->held.rank_mask || o->held.groups[2] || o->held.groups[3] ||
+            o->held.groups[4]) continue;
+        if (o->held.cards > 0 && o->held.suit_ranks[suit] == 0) continue;
+        
+        unsigned int avail = o->unseen_suit[suit];
+        for (unsigned int pick = avail; pick; pick = (pick - 1) & avail) {
+            if (__builtin_popcount(pick) != left) continue;
+            unsigned int ranks = o->held.rank_mask | pick;
+            if (is_straight(ranks)) {
+                o->outcomes[STRAIGHT]--;
+                o->outcomes[STRAIGHT_FLUSH]++;
+            } else {
+                o->outcomes[HIGH_CARD]--;
+                o->outcomes[FLUSH]++;
+            }
+        }
+    }
+}
+
+/* Recount every outcome for the current discard set */
+static void odds_update(DrawOdds* o) {
+    TRACE_SCOPE("odds_update");
+    memset(o->outcomes, 0, sizeof(o->outcomes));
+    int left = HAND_SIZE - o->held.cards;
+    if (left == 0) {
+        o->outcomes[shape_class(&o->held)] = 1;
+        o->combos = 1;
+        return;
+    }
+    
+    HandShape s = o->held;
+    walk_ranks(o, &s, 0, left, 1);
+    count_flushes(o, left);
+    o->combos = 0;
+    for (int c = 0; c < ODDS_CLASSES; c++) {
+        o->combos += o->outcomes[c];
+    }
+}
+
+/* Start from a freshly dealt or drawn hand with nothing marked to discard */
+void odds_init(DrawOdds* o, const Card* hand) {
+    memcpy(o->hand, hand, sizeof(o->hand));
+    o->discard_mask = 0;
+    shape_clear(&o->held);
+    for (int r = 0; r < 13; r++) {
+        o->unseen_count[r] = 4;
+    }
+    for (int suit = HEARTS; suit <= SPADES; suit++) {
+        o->unseen_suit[suit] = 0x1FFF;
+    }
+    
+    /* Our own cards, kept or thrown, can't come back */
+    for (int i = 0; i < HAND_SIZE; i++) {
+        shape_add(&o->held, hand[i]);
+        o->unseen_count[hand[i].rank - TWO]--;
+        o->unseen_suit[hand[i].suit] &= ~(1u << (hand[i].rank - TWO));
+    }
+    o->current = shape_class(&o->held);
+    odds_update(o);
+}
+
+/* Mark or unmark one card for discarding, moving it out of or back into the held shape */
+void odds_toggle(DrawOdds* o, int index) {
+    o->discard_mask ^= 1u << index;
+    if (o->discard_mask & (1u << index)) {
+        shape_remove(&o->held, o->hand[index]);
+    } else {
+        shape_add(&o->held, o->hand[index]);
+    }
+    odds_update(o);
+}
+
+/* Chance the draw finishes in exactly this class */
+double odds_chance(const DrawOdds* o, HandRank rank) {
+    return o->combos ? (double)o->outcomes[rank] / o->combos : 0.0;
+}
+
+/* Chance the draw finishes in a better class than the hand as dealt */
+double odds_improve(const DrawOdds* o) {
+    uint32_t better = 0;
+    for (int c = o->current + 1; c < ODDS_CLASSES; c++) {
+        better += o->outcomes[c];
+    }
+    return o->combos ? (double)better / o->combos : 0.0;
+}
@@ -0,0 +1,50 @@
+/*
+ * Poker Core - draw odds
+ * Exact chances of finishing in each hand class after discarding a given
+ * set of cards, over every combination of replacements from the 47 cards
+ * the drawing player hasn't seen. Hands are tracked as rank counts and
+ * per-suit rank masks that take one card in or out in O(1), so toggling a
+ * discard updates the held cards without re-evaluating them, and the
+ * enumeration adds and removes replacements the same way. Even a
+ * five-card draw takes microseconds, so the odds can follow every click.
+ */
+
+#ifndef POKER_ODDS_H
+#define POKER_ODDS_H
+
+#include "poker_core.h"
+
+#define ODDS_CLASSES (STRAIGHT_FLUSH + 1)
+
+/* A partial hand kept as counts - only the class of a full five cards is read back */
+typedef struct {
+    uint8_t rank_count[13];          /* Indexed by rank - 2 */
+    uint8_t groups[HAND_SIZE + 1];   /* How many ranks appear exactly N times */
+    uint16_t rank_mask;              /* Ranks present, bit rank - 2 */
+    uint16_t suit_ranks[4];          /* Ranks present in each suit */
+    int cards;
+} HandShape;
+
+/* The player's hand, which cards they would throw, and what the draw can make */
+typedef struct {
+    Card hand[HAND_SIZE];
+    uint8_t unseen_count[13];        /* Cards of each rank left to draw */
+    uint16_t unseen_suit[4];         /* Ranks left to draw in each suit */
+    unsigned int discard_mask;
+    HandShape held;                  /* The cards kept */
+    HandRank current;                /* Class of the hand as dealt */
+    uint32_t outcomes[ODDS_CLASSES]; /* Replacement combinations ending in each class */
+    uint32_t combos;
+} DrawOdds;
+
+void shape_clear(HandShape* s);
+void shape_add(HandShape* s, Card c);
+void shape_remove(HandShape* s, Card c);
+HandRank shape_class(const HandShape* s);
+
+void odds_init(DrawOdds* o, const Card* hand);
+void odds_toggle(DrawOdds* o, int index);
+double odds_chance(const DrawOdds* o, HandRank rank);
+double odds_improve(const DrawOdds* o);
+
+#endif
@@ -0,0 +1,38 @@
+/*
+ * Poker Core - random number generator
+ */
+
+#include "poker_core.h"
+
+/* Seed via splitmix64 so nearby seeds still give unrelated streams */
+void rng_seed(PokerRng* rng, uint64_t seed) {
+    uint64_t z = seed + 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    rng->state = z ? z : 1;  /* xorshift must never hold zero */
+}
+
+/* Next 32 random bits (xorshift64*) */
+uint32_t rng_next(PokerRng* rng) {
+    uint64_t x = rng->state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    rng->state = x;
+    return (uint32_t)((x * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+/* Uniform integer in [0, n) without modulo bias (Lemire's method) */
+int rng_range(PokerRng* rng, int n) {
+    uint64_t m = (uint64_t)rng_next(rng) * (uint32_t)n;
+    uint32_t low = (uint32_t)m;
+    if (low < (uint32_t)n) {
+        uint32_t threshold = (uint32_t)(-n) % (uint32_t)n;
+        while (low < threshold) {
+            m = (uint64_t)rng_next(rng) * (uint32_t)n;
+            low = (uint32_t)m;
+        }
+    }
+    return (int)(m >> 32);
+}
@@ -0,0 +1,134 @@
+/*
+ * Poker Core - opponent statistics
+ */
+
+#include "poker_stats.h"
+#include <stdio.h>
+#include <string.h>
+
+#define STATS_MAGIC "PKST"
+#define STATS_VERSION 1
+
+/* Shown hand ranks are summed at 1/8 scale so a run of straight flushes still fits 16 bits */
+#define SHOWN_SCALE (STATS_ONE / 8)
+
+/* Decay a counter by 1/32 and add amount (Q8.8) */
+static uint16_t bump(uint16_t counter, int amount) {
+    return (uint16_t)(counter - (counter >> STATS_DECAY_SHIFT) + amount);
+}
+
+/* Record one chance, and whether it was taken */
+static void rate_add(StatRate* r, int hit) {
+    r->chances = bump(r->chances, STATS_ONE);
+    r->hits = bump(r->hits, hit ? STATS_ONE : 0);
+}
+
+/* Clear every opponent */
+void stats_init(StatsStore* store) {
+    memset(store, 0, sizeof(*store));
+    for (int i = 0; i < STATS_MAX_OPPONENTS; i++) {
+        store->opponents[i].last_draw = -1;
+    }
+}
+
+/* Stats for one opponent, or NULL for an id out of range */
+OpponentStats* stats_get(StatsStore* store, int id) {
+    if (id < 0 || id >= STATS_MAX_OPPONENTS) return NULL;
+    return &store->opponents[id];
+}
+
+/* Fold one state machine event into the stats of whoever sits in seat */
+void stats_observe(OpponentStats* s, int seat, const PokerEvent* ev) {
+    switch (ev->type) {
+        case EVENT_ROUND_START:
+            s->hands++;
+            s->last_draw = -1;
+            s->at_showdown = 0;
+            break;
+        
+        case EVENT_ACTION: {
+            if (ev->seat != seat) break;
+            int street = ev->street < STATS_STREETS ? ev->street : STATS_STREETS - 1;
+            rate_add(&s->aggression[street], ev->action == ACTION_BET);
+            if (ev->facing_bet) {
+                rate_add(&s->fold_to_bet, ev->action == ACTION_FOLD);
+            } else {
+                rate_add(&s->open_bet, ev->action == ACTION_BET);
+            }
+            break;
+        }
+        
+        case EVENT_DRAW:
+            if (ev->seat == seat) s->last_draw = (int8_t)ev->cards;
+            break;
+        
+        case EVENT_SHOWDOWN:
+            /* Tie what they drew to what they turned over */
+            if (ev->seat != seat) break;
+            s->at_showdown = 1;
+            if (s->last_draw >= 0) {
+                s->shown_weight[s->last_draw] = bump(s->shown_weight[s->last_draw], STATS_ONE);
+                s->shown_sum[s->last_draw] = bump(s->shown_sum[s->last_draw], ev->hand_rank * SHOWN_SCALE);
+            }
+            break;
+        
+        case EVENT_ROUND_END:
+            rate_add(&s->showdown, s->at_showdown);
+            break;
+        
+        case EVENT_STATE:
+            break;
+    }
+}
+
+/* Frequency in permille, or -1 until there has been at least one chance */
+int stats_rate(StatRate r) {
+    if (r.chances < STATS_ONE) return -1;
+    return (int)((uint32_t)r.hits * 1000 / r.chances);
+}
+
+/* Average HandRank shown after drawing this many cards (Q8.8), or -1 if never seen */
+int stats_expected_rank(const OpponentStats* s, int cards_drawn) {
+    if (cards_drawn < 0 || cards_drawn > HAND_SIZE) return -1;
+    if (s->shown_weight[cards_drawn] < STATS_ONE) return -1;
+    return (int)((uint32_t)s->shown_sum[cards_drawn] * (STATS_ONE / SHOWN_SCALE) * STATS_ONE / s->shown_weight[cards_drawn]);
+}
+
+/* Read a store written by stats_save - returns 0 (leaving store untouched) on any mismatch */
+int stats_load(StatsStore* store, const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return 0;
+    
+    char magic[4];
+    uint32_t version, size;
+    StatsStore loaded;
+    int ok = fread(magic, sizeof(magic), 1, f) == 1 &&
+             memcmp(magic, STATS_MAGIC, sizeof(magic)) == 0 &&
+             fread(&version, sizeof(version), 1, f) == 1 && version == STATS_VERSION &&
+             fread(&size, sizeof(size), 1, f) == 1 && size == sizeof(loaded) &&
+             fread(&loaded, sizeof(loaded), 1, f) == 1;
+    fclose(f);
+    
+    if (ok) *store = loaded;
+    return ok;
+}
+
+/* Write the whole store - returns 0 on failure */
+int stats_save(const StatsStore* store, const char* path) {
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        printf("Failed to save opponent stats to %s\n", path);
+        return 0;
+    }
+    
+    uint32_t version = STATS_VERSION;
+    uint32_t size = sizeof(*store);
+    int ok = fwrite(STATS_MAGIC, 4, 1, f) == 1 &&
+             fwrite(&version, sizeof(version), 1, f) == 1 &&
+             fwrite(&size, sizeof(size), 1, f) == 1 &&
+             fwrite(store, sizeof(*store), 1, f) == 1;
+    if (fclose(f) != 0) ok = 0;
+    
+    if (!ok) printf("Failed to save opponent stats to %s\n", path);
+    return ok;
+}
@@ -0,0 +1,57 @@
+/*
+ * Poker Core - opponent statistics
+ * Running per-opponent tendencies fed straight from state machine events.
+ * Every update is O(1) and touches a few 16-bit fixed-point counters, so
+ * the AI can read current numbers on every decision without replaying
+ * hand history.
+ */
+
+#ifndef POKER_STATS_H
+#define POKER_STATS_H
+
+#include "poker_core.h"
+
+#define STATS_MAX_OPPONENTS 16
+#define STATS_STREETS 4            /* Streets tracked separately; later ones share the last slot */
+
+/*
+ * Counters are Q8.8 and decay by 1/32 each time they are bumped, so the
+ * numbers follow an opponent who changes gear, and a counter tops out near
+ * 32.0 (8192) with no chance of overflowing 16 bits.
+ */
+#define STATS_ONE 256
+#define STATS_DECAY_SHIFT 5
+
+/* A decayed hits-over-chances frequency */
+typedef struct {
+    uint16_t chances;
+    uint16_t hits;
+} StatRate;
+
+/* Everything known about one opponent */
+typedef struct {
+    uint32_t hands;                       /* Rounds observed */
+    StatRate open_bet;                    /* Opens the betting - bets when nothing is owed */
+    StatRate fold_to_bet;                 /* Folds when facing a bet */
+    StatRate aggression[STATS_STREETS];   /* Bets out of all actions, per street */
+    StatRate showdown;                    /* Rounds that reached a showdown */
+    uint16_t shown_weight[HAND_SIZE + 1]; /* Showdowns seen after drawing N cards (Q8.8) */
+    uint16_t shown_sum[HAND_SIZE + 1];    /* Matching decayed sum of HandRank shown, at 1/8 scale */
+    int8_t last_draw;                     /* Cards drawn this round, -1 if none yet */
+    int8_t at_showdown;                   /* This round reached their showdown */
+} OpponentStats;
+
+/* One entry per opponent, indexed by a caller-chosen id */
+typedef struct {
+    OpponentStats opponents[STATS_MAX_OPPONENTS];
+} StatsStore;
+
+void stats_init(StatsStore* store);
+OpponentStats* stats_get(StatsStore* store, int id);
+void stats_observe(OpponentStats* s, int seat, const PokerEvent* ev);
+int stats_rate(StatRate r);
+int stats_expected_rank(const OpponentStats* s, int cards_drawn);
+int stats_load(StatsStore* store, const char* path);
+int stats_save(const StatsStore* store, const char* path);
+
+#endif
@@ -0,0 +1,231 @@
+/*
+ * Poker Core - tournaments
+ */
+
+#include "poker_tourney.h"
+#include "poker_ai.h"
+#include <string.h>
+#include "trace.h"
+
+/* Fill in a standard freezeout: antes start at 1% of a stack and rise by half each level */
+void tourney_default_config(TourneyConfig* cfg, int players, int starting_chips) {
+    memset(cfg, 0, sizeof(*cfg));
+    if (players < 2) players = 2;
+    if (players > TOURNEY_MAX_PLAYERS) players = TOURNEY_MAX_PLAYERS;
+    
+    cfg->players = players;
+    cfg->starting_chips = starting_chips;
+    cfg->draw_rounds = 1;
+    cfg->hands_per_level = 10;
+    cfg->num_levels = TOURNEY_MAX_LEVELS;
+    cfg->human = -1;
+    
+    int ante = starting_chips / 100 > 0 ? starting_chips / 100 : 1;
+    for (int i = 0; i < TOURNEY_MAX_LEVELS; i++) {
+        cfg->levels[i].ante = ante;
+        cfg->levels[i].bet_size = 2 * ante;
+        ante += ante / 2 > 0 ? ante / 2 : 1;
+    }
+    
+    /* Pay roughly the top third of the field */
+    static const double pay_1[] = {1.0};
+    static const double pay_2[] = {0.65, 0.35};
+    static const double pay_3[] = {0.50, 0.30, 0.20};
+    static const double pay_5[] = {0.40, 0.25, 0.17, 0.10, 0.08};
+    const double* pay = pay_1;
+    cfg->paid = 1;
+    if (players >= 10) {
+        pay = pay_5;
+        cfg->paid = 5;
+    } else if (players >= 6) {
+        pay = pay_3;
+        cfg->paid = 3;
+    } else if (players >= 3) {
+        pay = pay_2;
+        cfg->paid = 2;
+    }
+    memcpy(cfg->payouts, pay, cfg->paid * sizeof(double));
+}
+
+/* Everyone starts with a full stack - returns 0 if the ICM workspace can't be allocated */
+int tourney_init(Tournament* t, const TourneyConfig* cfg, uint64_t seed) {
+    memset(t, 0, sizeof(*t));
+    t->cfg = *cfg;
+    rng_seed(&t->rng, seed);
+    t->icm = icm_new(cfg->payouts, cfg->paid);
+    if (!t->icm) return 0;
+    
+    for (int i = 0; i < cfg->players; i++) {
+        t->stacks[i] = cfg->starting_chips;
+    }
+    t->alive = cfg->players;
+    t->sitting_out = -1;
+    
+    PokerRules rules = {0};
+    poker_game_init(&t->table, &rules, 0);
+    return 1;
+}
+
+void tourney_free(Tournament* t) {
+    icm_free(t->icm);
+    t->icm = NULL;
+}
+
+/* Pair everyone still in at random heads-up tables; the human (if any) always gets table 0 */
+void tourney_seat(Tournament* t) {
+    TRACE_SCOPE("tourney_seat");
+    int order[TOURNEY_MAX_PLAYERS];
+    int n = 0;
+    for (int i = 0; i < t->cfg.players; i++) {
+        if (t->place[i] == 0) order[n++] = i;
+        t->hand_start[i] = t->stacks[i];
+    }
+    
+    for (int i = n - 1; i > 0; i--) {
+        int j = rng_range(&t->rng, i + 1);
+        int tmp = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+    for (int i = 0; i < n; i++) {
+        if (order[i] == t->cfg.human) {
+            order[i] = order[0];
+            order[0] = t->cfg.human;
+        }
+    }
+    
+    t->num_tables = n / 2;
+    for (int table = 0; table < t->num_tables; table++) {
+        t->seats[table][SEAT_PLAYER] = order[2 * table];
+        t->seats[table][SEAT_AI] = order[2 * table + 1];
+    }
+    t->sitting_out = n % 2 ? order[n - 1] : -1;
+}
+
+/*
+ * Point a game at one table for the next hand: current level's rules and
+ * both stacks, waiting in START_ROUND. The RNG and observer are left alone
+ * so a front end can keep its own game. A stack short of the ante posts
+ * what it has and the ante is cut to match.
+ */
+void tourney_load_table(const Tournament* t, int table, PokerGame* g) {
+    const TourneyLevel* lv = &t->cfg.levels[t->level];
+    int a = t->stacks[t->seats[table][SEAT_PLAYER]];
+    int b = t->stacks[t->seats[table][SEAT_AI]];
+    int shortest = a < b ? a : b;
+    
+    g->rules.starting_chips = t->cfg.starting_chips;
+    g->rules.ante = lv->ante < shortest ? lv->ante : shortest;
+    g->rules.bet_size = lv->bet_size;
+    g->rules.draw_rounds = t->cfg.draw_rounds;
+    g->rules.variant = t->cfg.variant;
+    g->chips[SEAT_PLAYER] = a;
+    g->chips[SEAT_AI] = b;
+    g->pot = 0;
+    g->state = START_ROUND;
+}
+
+/* Copy a finished hand's stacks back into the tournament */
+void tourney_store_table(Tournament* t, int table, const PokerGame* g) {
+    t->stacks[t->seats[table][SEAT_PLAYER]] = g->chips[SEAT_PLAYER];
+    t->stacks[t->seats[table][SEAT_AI]] = g->chips[SEAT_AI];
+}
+
+/* Play one hand at a table with the core AI in both seats */
+void tourney_play_table(Tournament* t, int table) {
+    TRACE_SCOPE("tourney_play_table");
+    PokerGame* g = &t->table;
+    uint64_t seed = (uint64_t)rng_next(&t->rng) << 32;
+    seed |= rng_next(&t->rng);
+    rng_seed(&g->rng, seed);
+    tourney_load_table(t, table, g);
+    poker_start_round(g);
+    
+    IcmSpot spot;
+    tourney_spot(t, table, &spot);
+    
+    while (g->state != ROUND_END && g->state != GAME_OVER) {
+        Seat seat = poker_acting_seat(g);
+        if (g->state == SHOWDOWN) {
+            poker_showdown(g);
+        } else if (g->state == PLAYER_DRAW || g->state == AI_DRAW) {
+            poker_draw(g, seat, ai_choose_discards(g, seat, NULL));
+        } else if (!poker_act(g, seat, ai_choose_tournament_action(g, seat, NULL, &spot))) {
+            poker_act(g, seat, g->to_call > 0 ? ACTION_CALL : ACTION_CHECK);
+        }
+    }
+    tourney_store_table(t, table, g);
+}
+
+/*
+ * After every table has stored its hand: knock out empty stacks, worst
+ * place to whoever started the hand shortest, and move up the ante
+ * schedule. The last player standing takes first place.
+ */
+void tourney_finish_hand(Tournament* t) {
+    TRACE_SCOPE("tourney_finish_hand");
+    int busted[TOURNEY_MAX_PLAYERS];
+    int n = 0;
+    for (int i = 0; i < t->cfg.players; i++) {
+        if (t->place[i] == 0 && t->stacks[i] <= 0) busted[n++] = i;
+    }
+    
+    /* Insertion sort by starting stack, shortest first - that player finishes lowest */
+    for (int i = 1; i < n; i++) {
+        int p = busted[i];
+        int j = i;
+        for (; j > 0 && t->hand_start[busted[j - 1]] > t->hand_start[p]; j--) {
+            busted[j] = busted[j - 1];
+        }
+        busted[j] = p;
+    }
+    for (int i = 0; i < n && t->alive > 1; i++) {
+        t->place[busted[i]] = t->alive--;
+    }
+    
+    if (t->alive == 1) {
+        for (int i = 0; i < t->cfg.players; i++) {
+            if (t->place[i] == 0) t->place[i] = 1;
+        }
+    }
+    
+    t->hands++;
+    t->level = t->hands / t->cfg.hands_per_level;
+    if (t->level >= t->cfg.num_levels) t->level = t->cfg.num_levels - 1;
+}
+
+/* ICM view of a table: every stack still in, as they stood before this hand */
+void tourney_spot(const Tournament* t, int table, IcmSpot* spot) {
+    spot->icm = t->icm;
+    spot->players = 0;
+    for (int i = 0; i < t->cfg.players; i++) {
+        if (t->place[i] != 0) continue;
+        for (int seat = 0; seat < NUM_SEATS; seat++) {
+            if (t->seats[table][seat] == i) spot->index[seat] = spot->players;
+        }
+        spot->stacks[spot->players++] = t->stacks[i];
+    }
+}
+
+int tourney_over(const Tournament* t) {
+    return t->alive <= 1;
+}
+
+/* Share of the prize pool a player has won - 0 until they have finished in the money */
+double tourney_prize(const Tournament* t, int player) {
+    int place = t->place[player];
+    if (place < 1 || place > t->cfg.paid) return 0.0;
+    return t->cfg.payouts[place - 1];
+}
+
+/* Play the whole tournament out with the AI at every seat */
+void tourney_run(Tournament* t) {
+    TRACE_SCOPE("tourney_run");
+    while (!tourney_over(t)) {
+        tourney_seat(t);
+        for (int table = 0; table < t->num_tables; table++) {
+            tourney_play_table(t, table);
+        }
+        tourney_finish_hand(t);
+    }
+}
@@ -0,0 +1,68 @@
+/*
+ * Poker Core - tournaments
+ * Sit-and-go and multi-table freezeouts over heads-up tables: every hand
+ * the players still in are paired off at tables, antes rise on a schedule
+ * of levels, and the bust order decides who gets which payout. Tables the
+ * front end isn't showing are played out by the core AI, which folds or
+ * calls by ICM prize equity rather than chips.
+ */
+
+#ifndef POKER_TOURNEY_H
+#define POKER_TOURNEY_H
+
+#include "poker_core.h"
+#include "poker_icm.h"
+
+#define TOURNEY_MAX_PLAYERS ICM_MAX_PLAYERS
+#define TOURNEY_MAX_TABLES (TOURNEY_MAX_PLAYERS / 2)
+#define TOURNEY_MAX_LEVELS 16
+
+/* One step of the ante schedule */
+typedef struct {
+    int ante;
+    int bet_size;
+} TourneyLevel;
+
+typedef struct {
+    int players;
+    int starting_chips;
+    int draw_rounds;
+    Variant variant;
+    int hands_per_level;
+    int num_levels;                          /* The last level repeats once reached */
+    TourneyLevel levels[TOURNEY_MAX_LEVELS];
+    int paid;
+    double payouts[ICM_MAX_PAID];            /* Share of the prize pool, first place first */
+    int human;                               /* Player always seated at table 0 as SEAT_PLAYER, -1 for none */
+} TourneyConfig;
+
+typedef struct {
+    TourneyConfig cfg;
+    PokerRng rng;
+    IcmWorkspace* icm;
+    int stacks[TOURNEY_MAX_PLAYERS];
+    int place[TOURNEY_MAX_PLAYERS];          /* Finishing place, 0 while still in */
+    int hand_start[TOURNEY_MAX_PLAYERS];     /* Stacks when this hand was seated, to order busts */
+    int alive;
+    int hands;                               /* Hands dealt so far - sets the level */
+    int level;
+    int num_tables;
+    int seats[TOURNEY_MAX_TABLES][NUM_SEATS];
+    int sitting_out;                         /* Player with no opponent this hand, -1 if none */
+    PokerGame table;                         /* Reused by tourney_play_table, so its deck is only reset between hands */
+} Tournament;
+
+void tourney_default_config(TourneyConfig* cfg, int players, int starting_chips);
+int tourney_init(Tournament* t, const TourneyConfig* cfg, uint64_t seed);
+void tourney_free(Tournament* t);
+void tourney_seat(Tournament* t);
+void tourney_load_table(const Tournament* t, int table, PokerGame* g);
+void tourney_store_table(Tournament* t, int table, const PokerGame* g);
+void tourney_play_table(Tournament* t, int table);
+void tourney_finish_hand(Tournament* t);
+void tourney_spot(const Tournament* t, int table, IcmSpot* spot);
+int tourney_over(const Tournament* t);
+double tourney_prize(const Tournament* t, int player);
+void tourney_run(Tournament* t);
+
+#endif
@@ -0,0 +1,68 @@
+/*
+ * Poker Core - game variants
+ *
+ * A hand's natural ranks r0 <= r1 <= ... <= r(k-1) (k = 5 - wild cards)
+ * index their table by colex rank: r_i + i is strictly increasing, so
+ * sum C(r_i + i, i + 1) numbers the C(12 + k, k) multisets of size k
+ * densely from 0. Wild cards sort to the end as rank 13 and add nothing.
+ */
+
+#include "poker_variant.h"
+#include "poker_variant_spec.h"
+#include <string.h>
+#include "trace.h"
+
+const VariantInfo* variant_info(Variant v) {
+    return &variants[v];
+}
+
+/* Variant with this key (e.g. "27"), or -1 */
+int variant_from_key(const char* key) {
+    for (int v = 0; v < NUM_VARIANTS; v++) {
+        if (strcmp(variants[v].key, key) == 0) return v;
+    }
+    return -1;
+}
+
+int variant_is_wild(Variant v, Card c) {
+    return c.rank == JOKER || (variants[v].wild != 0 && c.rank == variants[v].wild);
+}
+
+#define SORT2(a, b) do { int lo = a < b ? a : b; int hi = a ^ b ^ lo; a = lo; b = hi; } while (0)
+
+/* Score any hand of any variant - a sort, a sum and one table read */
+HandEval variant_evaluate(Variant v, const Card* hand) {
+    TRACE_SCOPE("variant_evaluate");
+    const VariantTables* t = &variant_tables[v];
+    int r[HAND_SIZE];
+    unsigned int rank_mask = 0, suit_mask = 0;
+    for (int i = 0; i < HAND_SIZE; i++) {
+        int wild = variant_is_wild(v, hand[i]);
+        r[i] = wild ? WILD_INDEX : hand[i].rank - TWO;
+        rank_mask |= (1u << r[i]) & 0x1FFF;
+        suit_mask |= wild ? 0 : 1u << hand[i].suit;
+    }
+    
+    /* Optimal five-element sorting network */
+    SORT2(r[0], r[1]); SORT2(r[3], r[4]); SORT2(r[2], r[4]);
+    SORT2(r[2], r[3]); SORT2(r[1], r[4]); SORT2(r[0], r[3]);
+    SORT2(r[0], r[2]); SORT2(r[1], r[3]); SORT2(r[1], r[2]);
+    
+    int naturals = 0;
+    int index = 0;
+    for (int i = 0; i < HAND_SIZE; i++) {
+        naturals += r[i] != WILD_INDEX;
+        index += variant_colex[i][r[i]];
+    }
+    
+    /* Every natural card in one suit and no two the same rank */
+    int suited = __builtin_popcount(suit_mask) == 1 && __builtin_popcount(rank_mask) == naturals;
+    uint32_t e = suited ? t->flush[rank_mask] : t->ranks[wild_offset[HAND_SIZE - naturals] + index];
+    
+    HandEval result;
+    result.rank = VARIANT_CLASS(e);
+    result.high_value = VARIANT_HIGH(e);
+    result.score = VARIANT_SCORE(e);
+    result.strength = t->beats[result.score];
+    return result;
+}
@@ -0,0 +1,60 @@
+/*
+ * Poker Core - game variants
+ * Five-card draw high, 2-7 triple draw and A-5 lowball, deuces wild and
+ * joker wild, chosen at runtime through PokerRules.variant.
+ *
+ * Every variant is evaluated the same way: wild cards drop out, the
+ * remaining natural ranks are sorted with a fixed network and turned into
+ * a combinatorial index, and one table lookup gives the hand's score (or,
+ * when every natural card shares a suit, one lookup by rank mask). The
+ * tables live in poker_tables.c, which gen_tables writes at build time,
+ * so no variant pays for branches another variant needs.
+ */
+
+#ifndef POKER_VARIANT_H
+#define POKER_VARIANT_H
+
+#include "poker_core.h"
+
+#define VARIANT_FLUSH_SIZE (1 << 13)
+#define VARIANT_RANKS_SIZE 8567      /* Multisets of 5, 4, ... 1 natural ranks */
+#define WILD_INDEX 13                /* A wild card's rank index - above every real rank, so it sorts last */
+
+/* Table entries pack the dense score (higher wins), the class to show and the top card */
+#define VARIANT_SCORE(e) ((int)((e) & 0xFFFF))
+#define VARIANT_CLASS(e) ((HandRank)(((e) >> 16) & 0xF))
+#define VARIANT_HIGH(e) ((int)(((e) >> 20) & 0xF))
+
+/* How a variant orders hands */
+typedef enum {
+    RULE_HIGH,               /* Best high hand, A-2-3-4-5 is a straight */
+    RULE_DEUCE_SEVEN,        /* Worst high hand wins, aces always high, straights and flushes count */
+    RULE_ACE_FIVE            /* Lowest wins, aces low, straights and flushes don't count */
+} VariantRule;
+
+/* One variant's rules - the list itself is in poker_variant_spec.h */
+typedef struct {
+    const char* name;        /* For menus and logs */
+    const char* key;         /* For command lines */
+    int draw_rounds;
+    int jokers;              /* Jokers added to the deck */
+    Rank wild;               /* Rank that plays as any card, 0 for none */
+    VariantRule rule;        /* RULE_HIGH, or one of the lowball orders */
+} VariantInfo;
+
+/* One variant's generated tables */
+typedef struct {
+    const uint32_t* ranks;   /* By wild count, then colex index of the sorted natural ranks */
+    const uint32_t* flush;   /* By rank mask, when every natural card is one suit */
+    const uint16_t* beats;   /* Permille of the variant's hands each score beats */
+} VariantTables;
+
+extern const VariantTables variant_tables[NUM_VARIANTS];
+extern const uint16_t variant_colex[HAND_SIZE][WILD_INDEX + 1];   /* C(r + i, i + 1), 0 for a wild card */
+
+const VariantInfo* variant_info(Variant v);
+int variant_from_key(const char* key);
+HandEval variant_evaluate(Variant v, const Card* hand);
+int variant_is_wild(Variant v, Card c);
+
+#endif
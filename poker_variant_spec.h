@@ -0,0 +1,27 @@
+/*
+ * Poker Core - variant definitions
+ * Included by poker_variant.c and by gen_tables, so the game and the
+ * table generator read the same rules and table layout. Nothing else
+ * should include it - the tables are static in each includer.
+ */
+
+#ifndef POKER_VARIANT_SPEC_H
+#define POKER_VARIANT_SPEC_H
+
+#include "poker_variant.h"
+
+static const VariantInfo variants[NUM_VARIANTS] = {
+    {"Five-Card Draw", "draw", 1, 0, 0, RULE_HIGH},
+    {"2-7 Triple Draw", "27", 3, 0, 0, RULE_DEUCE_SEVEN},
+    {"A-5 Lowball", "a5", 1, 0, 0, RULE_ACE_FIVE},
+    {"Deuces Wild", "deuces", 1, 0, TWO, RULE_HIGH},
+    {"Joker Wild", "joker", 1, 1, JOKER, RULE_HIGH}
+};
+
+/*
+ * Where each wild count's block starts in a ranks table: sums of
+ * C(12 + k, k) for k = 5, 4, ..., ending with the table size
+ */
+static const int wild_offset[HAND_SIZE + 1] = {0, 6188, 8008, 8463, 8554, VARIANT_RANKS_SIZE};
+
+#endif
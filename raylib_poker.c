@@ -4,61 +4,44 @@
 #include <string.h>
 #include <time.h>
 #include <math.h>
+#include "poker_core.h"
+#include "poker_stats.h"
+#include "poker_ai.h"
+#include "poker_tourney.h"
+#include "poker_odds.h"
+#include "poker_variant.h"
+#include "table_stream.h"
+#include "trace.h"
+
+#define STARTING_CHIPS 1000
+#define ANTE 10
+#define BET_SIZE 20
+#define STATS_FILE "opponent_stats.dat"
+#define PLAYER_STATS_ID 0
+#define TOURNEY_PLAYERS 6
+#define TOURNEY_HUMAN 0
+#define CARD_W 60
+#define CARD_H 90
+#define CARD_SPACING 70
+#define HAND_X 180
+#define PLAYER_HAND_Y 390
+#define DISCARD_LIFT 20
+
+// button looks - every label a button can show is rendered in each look at startup
+enum { BUTTON_NORMAL, BUTTON_HOVER, BUTTON_DISABLED, BUTTON_STATES };
+#define BUTTON_LABELS 6
 
 
-typedef enum { HEARTS, DIAMONDS, CLUBS, SPADES } Suit;
-typedef enum {
-    RANK_2, RANK_3, RANK_4, RANK_5, RANK_6, RANK_7,
-    RANK_8, RANK_9, RANK_10, RANK_J, RANK_Q, RANK_K, RANK_A
-} Rank;
-
-typedef struct {
-    Rank rank;
-    Suit suit;
-} Card;
-
-typedef struct {
-    int top;
-    Card cards[52];
-} DeckStack;
-
-typedef enum {
-    HAND_HIGH_CARD,
-    HAND_PAIR,
-    HAND_TWO_PAIR,
-    HAND_TRIPS,
-    HAND_STRAIGHT,
-    HAND_FLUSH,
-    HAND_FULL_HOUSE,
-    HAND_QUADS,
-    HAND_STRAIGHT_FLUSH
-} HandRank;
-
-typedef struct {
-    HandRank rank;
-    Rank high_card_rank;
-} HandEvaluation;
-
 typedef struct {
     Rectangle rect;
-    const char *text;
+    const char *text;                          // label shown now, one of labels
+    const char *labels[BUTTON_LABELS];
+    int label_count;
     bool enabled;
     bool visible;
+    RenderTexture2D cache[BUTTON_LABELS][BUTTON_STATES];
 } Button;
 
-typedef enum {
-    GAME_STATE_MENU,
-    GAME_STATE_INIT_ROUND,
-    GAME_STATE_BETTING_1,
-    GAME_STATE_AI_TURN_1,
-    GAME_STATE_PLAYER_DRAW,
-    GAME_STATE_AI_DRAW,
-    GAME_STATE_BETTING_2,
-    GAME_STATE_AI_TURN_2,
-    GAME_STATE_SHOWDOWN,
-    GAME_STATE_ROUND_END
-} GameState;
-
 typedef struct {
     bool discard_mask[5];
     int discard_count;
@@ -67,17 +50,24 @@ typedef struct {
 
 
 Font main_font;
-Card deck[52];
-DeckStack deck_stack;
-Card player_hand[5];
-Card ai_hand[5];
-GameState current_state = GAME_STATE_MENU;
-Button btn_bet20, btn_check, btn_fold;
-float pot = 0;
-float current_bet = 0;
-float player_chips = 1000;
-float ai_chips = 1000;
-bool round_initialized = false;
+// pre-rendered card faces, indexed like init_deck, the joker and the card back
+RenderTexture2D card_faces[DECK_SIZE];
+RenderTexture2D card_joker;
+RenderTexture2D card_back;
+// one betting round, one draw, one more betting round - the menu can switch the variant
+const PokerRules raylib_rules = { STARTING_CHIPS, ANTE, BET_SIZE, 1, VARIANT_DRAW_HIGH };
+PokerGame game;
+bool show_menu = true;
+// what the ai has learned about the player, kept across sessions
+StatsStore opponent_stats;
+// tournament mode (T on the menu): you sit at table 0, the core ai plays the other tables
+Tournament tourney;
+bool tourney_mode = false;
+Button btn_bet20, btn_check, btn_fold, btn_draw;
+// discards picked so far in the draw phase, and (high draw only) what they can make
+unsigned int discard_mask = 0;
+DrawOdds draw_odds;
+bool draw_odds_ready = false;
 char game_log[20][128];
 int log_count = 0;
 
@@ -90,96 +80,55 @@ void add_to_log(const char *msg) {
     }
 }
 
-const char *rank_to_string(Rank r) {
-    static const char *names[] = {"2","3","4","5","6","7","8","9","10","J","Q","K","A"};
-    return names[r];
-}
-
-const char *suit_to_string(Suit s) {
+const char *suit_to_symbol(Suit s) {
     static const char *names[] = {"♥","♦","♣","♠"};
     return names[s];
 }
 
-int rank_to_int(Rank rank) { return (int)rank; }
-
-int compare_cards(const void *a, const void *b) {
-    Card *ca = (Card *)a;
-    Card *cb = (Card *)b;
-    return rank_to_int(cb->rank) - rank_to_int(ca->rank);
-}
-
-// deck management
-void init_deck(DeckStack *stack) {
-    stack->top = 0;
-    int index = 0;
-    for (int s = 0; s < 4; s++) {
-        for (int r = 0; r < 13; r++) {
-            stack->cards[index++] = (Card){r, s};
-        }
-    }
-}
-
-void shuffle_deck(DeckStack *stack) {
-    for (int i = 0; i < 52; i++) {
-        int j = rand() % 52;
-        Card temp = stack->cards[i];
-        stack->cards[i] = stack->cards[j];
-        stack->cards[j] = temp;
-    }
-    stack->top = 0;
-}
-
-Card deal_card(DeckStack *stack) {
-    if (stack->top >= 52) stack->top = 0;
-    return stack->cards[stack->top++];
-}
-
-// hand evaluation 
-HandEvaluation evaluate_hand(Card *hand, int hand_size) {
-    HandEvaluation eval = { HAND_HIGH_CARD, RANK_2 };
-    for (int i = 0; i < hand_size; i++) {
-        if (hand[i].rank > eval.high_card_rank)
-            eval.high_card_rank = hand[i].rank;
-    }
-    return eval;
-}
-
-int compare_hands(HandEvaluation player_eval, HandEvaluation ai_eval) {
-    if (player_eval.rank > ai_eval.rank) return 1;
-    if (player_eval.rank < ai_eval.rank) return -1;
-    if (player_eval.high_card_rank > ai_eval.high_card_rank) return 1;
-    if (player_eval.high_card_rank < ai_eval.high_card_rank) return -1;
-    return 0;
+// ai bot 
+// every game event goes into the player's running stats, and out to the table stream if open
+void observe_player(void *ctx, const PokerEvent *ev) {
+    stats_observe((OpponentStats *)ctx, SEAT_PLAYER, ev);
+    table_stream_publish(&game, ev);
 }
 
-// ai bot 
 void ai_action() {
-    int choice = rand() % 3;
-    switch (choice) {
-        case 0:
-            add_to_log("AI checks.");
-            current_state = (current_state == GAME_STATE_AI_TURN_1)
-                            ? GAME_STATE_PLAYER_DRAW
-                            : GAME_STATE_SHOWDOWN;
-            break;
-        case 1:
-            add_to_log("AI bets 20.");
-            ai_chips -= 20; pot += 20; current_bet = 20;
-            current_state = (current_state == GAME_STATE_AI_TURN_1)
-                            ? GAME_STATE_BETTING_1
-                            : GAME_STATE_BETTING_2;
-            break;
-        case 2:
-            add_to_log("AI folds. You win the pot!");
-            player_chips += pot;
-            current_state = GAME_STATE_ROUND_END;
-            break;
+    TRACE_SCOPE("ai_action");
+    OpponentStats *opp = stats_get(&opponent_stats, PLAYER_STATS_ID);
+    Action a;
+    StreamCommand cmd;
+    if (table_stream_bot(&game, SEAT_AI)) {
+        // a bot on the table stream has the seat - try again next frame until it answers
+        if (!table_stream_poll(SEAT_AI, &cmd) || cmd.kind != STREAM_CMD_ACT) return;
+        a = (Action)cmd.action;
+    } else if (tourney_mode) {
+        IcmSpot spot;
+        tourney_spot(&tourney, 0, &spot);
+        a = ai_choose_tournament_action(&game, SEAT_AI, opp, &spot);
+    } else {
+        a = ai_choose_action(&game, SEAT_AI, opp);
+    }
+    if (!poker_act(&game, SEAT_AI, a)) return;
+    switch (a) {
+        case ACTION_CHECK: add_to_log("AI checks."); break;
+        case ACTION_BET: add_to_log(TextFormat("AI bets %d.", game.rules.bet_size)); break;
+        case ACTION_CALL: add_to_log("AI calls."); break;
+        case ACTION_FOLD: add_to_log("AI folds. You win the pot!"); break;
     }
 }
 
 void ai_draw_cards() {
-    add_to_log("AI draws 1 card (placeholder).");
-    ai_hand[rand() % 5] = deal_card(&deck_stack);
+    TRACE_SCOPE("ai_draw_cards");
+    unsigned int mask;
+    StreamCommand cmd;
+    if (table_stream_bot(&game, SEAT_AI)) {
+        if (!table_stream_poll(SEAT_AI, &cmd) || cmd.kind != STREAM_CMD_DRAW) return;
+        mask = cmd.discard_mask;
+    } else {
+        mask = ai_choose_discards(&game, SEAT_AI, stats_get(&opponent_stats, PLAYER_STATS_ID));
+    }
+    int drawn = poker_draw(&game, SEAT_AI, mask);
+    add_to_log(drawn ? TextFormat("AI draws %d.", drawn) : "AI stands pat.");
 }
 
 DrawStrategy get_ai_draw_potential(Card* hand) {
@@ -188,181 +137,385 @@ DrawStrategy get_ai_draw_potential(Card* hand) {
     return ds;
 }
 
-// button 
-void draw_button(Button button) {
-    if (!button.visible) return;
-
-    Vector2 mpos = GetMousePosition();
-    bool hover = CheckCollisionPointRec(mpos, button.rect);
-    float scale = 1.0f;
+// render textures come out upside down, so every cached quad is drawn with a flipped source rect
+void draw_cached(RenderTexture2D rt, float x, float y) {
+    DrawTextureRec(rt.texture, (Rectangle){0, 0, (float)rt.texture.width, (float)-rt.texture.height}, (Vector2){x, y}, WHITE);
+}
 
-    if (hover && button.enabled) scale = 1.06f;
-    if (!button.enabled) scale = 0.97f;
+// card faces and back are drawn once at startup, then each card is one textured quad
+void build_card_cache() {
+    TRACE_SCOPE("build_card_cache");
+    Rectangle card_rect = { 0, 0, CARD_W, CARD_H };
+    for (int suit = HEARTS; suit <= SPADES; suit++) {
+        for (int rank = TWO; rank <= ACE; rank++) {
+            RenderTexture2D *rt = &card_faces[suit * 13 + rank - TWO];
+            *rt = LoadRenderTexture(CARD_W, CARD_H);
+            BeginTextureMode(*rt);
+            ClearBackground(BLANK);
+            DrawRectangleRounded(card_rect, 0.1f, 6, WHITE);
+            DrawRectangleRoundedLines(card_rect, 0.1f, 6, 2, DARKGRAY);
+            DrawText(rank_to_string(rank), 8, 10, 20, BLACK);
+            DrawText(suit_to_symbol(suit), 8, 40, 20, (suit < 2) ? RED : BLACK);
+            EndTextureMode();
+        }
+    }
 
-    Rectangle r = button.rect;
-    float w = r.width * scale;
-    float h = r.height * scale;
-    float x = r.x + (r.width - w) / 2.0f;
-    float y = r.y + (r.height - h) / 2.0f;
+    card_joker = LoadRenderTexture(CARD_W, CARD_H);
+    BeginTextureMode(card_joker);
+    ClearBackground(BLANK);
+    DrawRectangleRounded(card_rect, 0.1f, 6, WHITE);
+    DrawRectangleRoundedLines(card_rect, 0.1f, 6, 2, PURPLE);
+    DrawText("Jk", 8, 10, 20, PURPLE);
+    DrawText("*", 8, 40, 20, PURPLE);
+    EndTextureMode();
+
+    card_back = LoadRenderTexture(CARD_W, CARD_H);
+    BeginTextureMode(card_back);
+    ClearBackground(BLANK);
+    DrawRectangle(0, 0, CARD_W, CARD_H, BLUE);
+    DrawRectangleLines(0, 0, CARD_W, CARD_H, GOLD);
+    EndTextureMode();
+}
 
-    Color base = button.enabled ? (hover ? (Color){70, 130, 180, 255} : (Color){60, 110, 160, 255})
-                                : (Color){80, 80, 80, 180};
-    Color outline = button.enabled ? RAYWHITE : GRAY;
+// size of a button look - hover grows it a little, disabled shrinks it
+Rectangle button_look_rect(Button *button, int state) {
+    Rectangle r = button->rect;
+    float scale = state == BUTTON_HOVER ? 1.06f : state == BUTTON_DISABLED ? 0.97f : 1.0f;
+    float w = (float)(int)(r.width * scale + 0.5f);
+    float h = (float)(int)(r.height * scale + 0.5f);
+    return (Rectangle){ r.x + (r.width - w) / 2.0f, r.y + (r.height - h) / 2.0f, w, h };
+}
 
+// paint one button look with its top-left corner at x, y
+void paint_button(const char *text, float x, float y, float w, float h, int state) {
+    Color base = state == BUTTON_HOVER ? (Color){70, 130, 180, 255}
+               : state == BUTTON_NORMAL ? (Color){60, 110, 160, 255}
+                                        : (Color){80, 80, 80, 180};
+    Color outline = state == BUTTON_DISABLED ? GRAY : RAYWHITE;
     DrawRectangleRounded((Rectangle){x, y, w, h}, 0.2f, 8, base);
     DrawRectangleRoundedLines((Rectangle){x, y, w, h}, 0.2f, 8, 2.0f, outline);
-
-    Vector2 text_size = MeasureTextEx(main_font, button.text, 20, 1);
+    Vector2 text_size = MeasureTextEx(main_font, text, 20, 1);
     DrawTextEx(main_font,
-               button.text,
+               text,
                (Vector2){x + (w - text_size.x) / 2.0f, y + (h - text_size.y) / 2.0f + 2},
                20,
                1,
                RAYWHITE);
 }
 
+// render every label of a button in every look, once at startup
+void build_button_cache(Button *button) {
+    TRACE_SCOPE("build_button_cache");
+    for (int label = 0; label < button->label_count; label++) {
+        for (int state = 0; state < BUTTON_STATES; state++) {
+            Rectangle look = button_look_rect(button, state);
+            button->cache[label][state] = LoadRenderTexture((int)look.width, (int)look.height);
+            BeginTextureMode(button->cache[label][state]);
+            ClearBackground(BLANK);
+            paint_button(button->labels[label], 0, 0, look.width, look.height, state);
+            EndTextureMode();
+        }
+    }
+}
+
+// button 
+void draw_button(Button *button) {
+    TRACE_SCOPE("draw_button");
+    if (!button->visible) return;
+
+    Vector2 mpos = GetMousePosition();
+    bool hover = CheckCollisionPointRec(mpos, button->rect);
+    int state = !button->enabled ? BUTTON_DISABLED : hover ? BUTTON_HOVER : BUTTON_NORMAL;
+    Rectangle look = button_look_rect(button, state);
+
+    // labels are matched by content, so a label built at runtime still finds its texture
+    for (int label = 0; label < button->label_count; label++) {
+        if (strcmp(button->labels[label], button->text) != 0) continue;
+        draw_cached(button->cache[label][state], look.x, look.y);
+        return;
+    }
+    // a label nobody listed is painted directly rather than loading textures mid-frame
+    paint_button(button->text, look.x, look.y, look.width, look.height, state);
+}
+
+void unload_render_caches() {
+    for (int i = 0; i < DECK_SIZE; i++) UnloadRenderTexture(card_faces[i]);
+    UnloadRenderTexture(card_joker);
+    UnloadRenderTexture(card_back);
+    Button *buttons[] = { &btn_bet20, &btn_check, &btn_fold, &btn_draw };
+    for (int b = 0; b < 4; b++) {
+        for (int label = 0; label < buttons[b]->label_count; label++) {
+            for (int state = 0; state < BUTTON_STATES; state++) UnloadRenderTexture(buttons[b]->cache[label][state]);
+        }
+    }
+}
+
+
+// cash-game bet and call labels, built from the rules so they match the cached textures
+char bet_text[16], call_text[16];
+// the draw button's label for each number of marked cards
+const char *draw_labels[] = { "Stand Pat", "Draw 1", "Draw 2", "Draw 3", "Draw 4", "Draw 5" };
 
 void init_buttons() {
-    btn_bet20 = (Button){ .rect = {380, 500, 100, 40}, .text = "Bet 20", .enabled = true, .visible = false };
-    btn_check = (Button){ .rect = {500, 500, 100, 40}, .text = "Check", .enabled = true, .visible = false };
-    btn_fold  = (Button){ .rect = {620, 500, 100, 40}, .text = "Fold",  .enabled = true, .visible = false };
+    snprintf(bet_text, sizeof(bet_text), "Bet %d", raylib_rules.bet_size);
+    snprintf(call_text, sizeof(call_text), "Call %d", raylib_rules.bet_size);
+    btn_bet20 = (Button){ .rect = {380, 500, 100, 40}, .text = bet_text, .enabled = true, .visible = false,
+                          .labels = { bet_text, call_text, "Bet", "Call" }, .label_count = 4 };
+    btn_check = (Button){ .rect = {500, 500, 100, 40}, .text = "Check", .enabled = true, .visible = false,
+                          .labels = { "Check" }, .label_count = 1 };
+    btn_fold  = (Button){ .rect = {620, 500, 100, 40}, .text = "Fold",  .enabled = true, .visible = false,
+                          .labels = { "Fold" }, .label_count = 1 };
+    btn_draw  = (Button){ .rect = {380, 500, 110, 40}, .text = "Stand Pat", .enabled = true, .visible = false,
+                          .label_count = HAND_SIZE + 1 };
+    for (int i = 0; i <= HAND_SIZE; i++) btn_draw.labels[i] = draw_labels[i];
+
+    Button *buttons[] = { &btn_bet20, &btn_check, &btn_fold, &btn_draw };
+    for (int b = 0; b < 4; b++) build_button_cache(buttons[b]);
 }
 
-void init_round() {
-    init_deck(&deck_stack);
-    shuffle_deck(&deck_stack);
+// tournament: settle your table, play a hand at every other table, seat the next hand.
+// false once you're out or have won
+bool tourney_advance() {
+    TRACE_SCOPE("tourney_advance");
+    if (game.state == ROUND_END) {
+        int alive = tourney.alive;
+        int level = tourney.level;
+        tourney_store_table(&tourney, 0, &game);
+        for (int table = 1; table < tourney.num_tables; table++) tourney_play_table(&tourney, table);
+        tourney_finish_hand(&tourney);
+        if (tourney.alive != alive) add_to_log(TextFormat("%d players left.", tourney.alive));
+        if (tourney.level != level) add_to_log(TextFormat("Level %d: antes go up.", tourney.level + 1));
+    }
 
-    for (int i = 0; i < 5; i++) {
-        player_hand[i] = deal_card(&deck_stack);
-        ai_hand[i] = deal_card(&deck_stack);
+    int place = tourney.place[TOURNEY_HUMAN];
+    if (place != 0) {
+        add_to_log(TextFormat("Tournament over - you finished %d of %d and won %.0f%% of the prizes.",
+                              place, tourney.cfg.players, tourney_prize(&tourney, TOURNEY_HUMAN) * 100.0));
+        game.state = GAME_OVER;
+        return false;
     }
 
-    pot = 20;
-    player_chips -= 10;
-    ai_chips -= 10;
+    tourney_seat(&tourney);
+    tourney_load_table(&tourney, 0, &game);
+    return true;
+}
 
-    add_to_log("New round started. Ante 10 from each player.");
-    round_initialized = true;
-    current_state = GAME_STATE_BETTING_1;
+void init_round() {
+    TRACE_SCOPE("init_round");
+    if (tourney_mode && !tourney_advance()) return;
+    if (!poker_start_round(&game)) {
+        add_to_log(game.chips[SEAT_PLAYER] < game.rules.ante ? "You can't pay the ante. Game over."
+                                                             : "AI can't pay the ante. You win!");
+        return;
+    }
+    add_to_log(TextFormat("New round started. Ante %d from each player.", game.rules.ante));
 }
 
-// drawing functions
-void draw_hand(Card *hand, int x, int y, bool hidden) {
+void showdown() {
+    poker_showdown(&game);
+    if (game.winner == SEAT_PLAYER) add_to_log(TextFormat("You win the showdown with %s!", hand_rank_to_string(game.evals[SEAT_PLAYER].rank)));
+    else if (game.winner == SEAT_AI) add_to_log(TextFormat("AI wins the showdown with %s!", hand_rank_to_string(game.evals[SEAT_AI].rank)));
+    else add_to_log("It's a tie! Pot split.");
+}
+
+RenderTexture2D card_texture(Card c) {
+    return c.rank == JOKER ? card_joker : card_faces[c.suit * 13 + c.rank - TWO];
+}
+
+// drawing functions - cards in the lifted mask are drawn raised (marked to discard)
+void draw_hand(Card *hand, int x, int y, bool hidden, unsigned int lifted) {
+    TRACE_SCOPE("draw_hand");
     for (int i = 0; i < 5; i++) {
-        Rectangle card_rect = { x + i * 70, y, 60, 90 };
-        DrawRectangleRounded(card_rect, 0.1f, 6, WHITE);
-        DrawRectangleRoundedLines(card_rect, 0.1f, 6, 2, DARKGRAY);
-        if (!hidden) {
-            DrawText(rank_to_string(hand[i].rank), x + i * 70 + 8, y + 10, 20, BLACK);
-            DrawText(suit_to_string(hand[i].suit), x + i * 70 + 8, y + 40, 20, (hand[i].suit < 2) ? RED : BLACK);
-        } else {
-            DrawRectangle(x + i * 70, y, 60, 90, BLUE);
-            DrawRectangleLines(x + i * 70, y, 60, 90, GOLD);
+        RenderTexture2D rt = hidden ? card_back : card_texture(hand[i]);
+        draw_cached(rt, x + i * CARD_SPACING, y - ((lifted >> i) & 1 ? DISCARD_LIFT : 0));
+    }
+}
+
+// hint panel: what you hold, and in the draw phase of high draw what the marked discards can turn into
+void draw_hints() {
+    TRACE_SCOPE("draw_hints");
+    int x = 560, y = 330;
+    if (game.state == PLAYER_DRAW && draw_odds_ready && game.rules.variant == VARIANT_DRAW_HIGH) {
+        DrawText(TextFormat("You hold %s", hand_rank_to_string(draw_odds.current)), x, y, 16, GOLD);
+        if (draw_odds.discard_mask == 0) {
+            DrawText("Click cards to mark discards", x, y + 20, 14, LIGHTGRAY);
+            return;
+        }
+        DrawText(TextFormat("Improves %.1f%% of the time", odds_improve(&draw_odds) * 100.0), x, y + 20, 14, WHITE);
+        int line = 0;
+        for (int c = STRAIGHT_FLUSH; c >= HIGH_CARD; c--) {
+            double p = odds_chance(&draw_odds, (HandRank)c);
+            if (p == 0.0) continue;
+            Color col = c > (int)draw_odds.current ? GREEN : LIGHTGRAY;
+            DrawText(TextFormat("%-16s %6.2f%%", hand_rank_to_string((HandRank)c), p * 100.0), x, y + 40 + line++ * 14, 12, col);
         }
+    } else if (game.state != ROUND_END && game.state != GAME_OVER) {
+        HandEval e = variant_evaluate(game.rules.variant, game.hands[SEAT_PLAYER]);
+        DrawText(TextFormat("You hold %s", hand_rank_to_string(e.rank)), x, y, 16, GOLD);
+        DrawText(TextFormat("Beats %d%% of hands", (e.strength + 5) / 10), x, y + 20, 14, WHITE);
+        if (game.state == PLAYER_DRAW && discard_mask == 0) DrawText("Click cards to mark discards", x, y + 40, 14, LIGHTGRAY);
     }
 }
 
 void draw_ui() {
-    DrawText(TextFormat("Player: $%.0f", player_chips), 50, 450, 20, WHITE);
-    DrawText(TextFormat("AI: $%.0f", ai_chips), 50, 50, 20, WHITE);
-    DrawText(TextFormat("Pot: $%.0f", pot), 400, 300, 25, YELLOW);
+    TRACE_SCOPE("draw_ui");
+    DrawText(TextFormat("Player: $%d", game.chips[SEAT_PLAYER]), 50, 450, 20, WHITE);
+    DrawText(TextFormat("AI: $%d", game.chips[SEAT_AI]), 50, 50, 20, WHITE);
+    DrawText(TextFormat("Pot: $%d", game.pot), 400, 300, 25, YELLOW);
     DrawText("Your Hand:", 50, 400, 20, LIGHTGRAY);
-    draw_hand(player_hand, 180, 390, false);
+    unsigned int lifted = game.state == PLAYER_DRAW && draw_odds_ready ? discard_mask : 0;
+    draw_hand(game.hands[SEAT_PLAYER], HAND_X, PLAYER_HAND_Y, false, lifted);
     DrawText("AI Hand:", 50, 150, 20, LIGHTGRAY);
-    draw_hand(ai_hand, 180, 140, current_state != GAME_STATE_SHOWDOWN);
-    draw_button(btn_bet20);
-    draw_button(btn_check);
-    draw_button(btn_fold);
+    draw_hand(game.hands[SEAT_AI], HAND_X, 140, !game.revealed, 0);
+    draw_hints();
+    DrawText(variant_info(game.rules.variant)->name, 400, 30, 16, LIGHTGRAY);
+    if (tourney_mode) {
+        DrawText(TextFormat("Level %d  Ante %d  Bet %d  Players left %d", tourney.level + 1,
+                            game.rules.ante, game.rules.bet_size, tourney.alive), 400, 50, 16, GOLD);
+    }
+    draw_button(&btn_bet20);
+    draw_button(&btn_check);
+    draw_button(&btn_fold);
+    draw_button(&btn_draw);
 }
 
 // main function
 int main(void) {
+    TRACE_THREAD_NAME("main");
     InitWindow(800, 600, "Raylib Poker Game");
     SetTargetFPS(60);
-    srand(time(NULL));
+    uint64_t seed = (uint64_t)time(NULL);
+    poker_game_init(&game, &raylib_rules, seed);
+    stats_init(&opponent_stats);
+    stats_load(&opponent_stats, STATS_FILE);
+    poker_set_observer(&game, observe_player, stats_get(&opponent_stats, PLAYER_STATS_ID));
+    // POKER_STREAM=1 (or a shm name) publishes the table for table_watch, and bots may take the ai seat
+    const char *stream_name = getenv("POKER_STREAM");
+    if (stream_name && *stream_name) table_stream_open(strcmp(stream_name, "1") == 0 ? STREAM_DEFAULT_NAME : stream_name, 1u << SEAT_AI);
 
     main_font = GetFontDefault();
     init_buttons();
+    build_card_cache();
 
     while (!WindowShouldClose()) {
         // Input
-        if (current_state == GAME_STATE_MENU && IsKeyPressed(KEY_ENTER)) {
-            current_state = GAME_STATE_INIT_ROUND;
-        }
-
-        if (current_state == GAME_STATE_INIT_ROUND && !round_initialized) {
+        if (show_menu && IsKeyPressed(KEY_ENTER)) {
+            show_menu = false;
+            init_round();
+        } else if (show_menu && IsKeyPressed(KEY_T)) {
+            TourneyConfig cfg;
+            tourney_default_config(&cfg, TOURNEY_PLAYERS, STARTING_CHIPS);
+            cfg.draw_rounds = game.rules.draw_rounds;
+            cfg.variant = game.rules.variant;
+            cfg.human = TOURNEY_HUMAN;
+            if (tourney_init(&tourney, &cfg, seed + 1)) {
+                tourney_mode = true;
+                show_menu = false;
+                add_to_log(TextFormat("Tournament: %d players, top %d paid.", cfg.players, cfg.paid));
+                init_round();
+            }
+        } else if (show_menu) {
+            // 1-5 pick the game; the variant decides how many draws there are
+            for (int v = 0; v < NUM_VARIANTS; v++) {
+                if (!IsKeyPressed(KEY_ONE + v)) continue;
+                game.rules.variant = (Variant)v;
+                game.rules.draw_rounds = variant_info((Variant)v)->draw_rounds;
+            }
+        } else if (game.state == ROUND_END && IsKeyPressed(KEY_ENTER)) {
             init_round();
         }
 
         // Button interactions
-        if (current_state == GAME_STATE_BETTING_1) {
-            btn_bet20.visible = btn_check.visible = btn_fold.visible = true;
-
-            if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
-                Vector2 mp = GetMousePosition();
-                if (CheckCollisionPointRec(mp, btn_bet20.rect)) {
-                    add_to_log("You bet 20.");
-                    player_chips -= 20; pot += 20;
-                    current_bet = 20;
-                    current_state = GAME_STATE_AI_TURN_1;
-                } else if (CheckCollisionPointRec(mp, btn_check.rect)) {
-                    add_to_log("You check.");
-                    current_state = GAME_STATE_AI_TURN_1;
-                } else if (CheckCollisionPointRec(mp, btn_fold.rect)) {
-                    add_to_log("You folded. AI wins the pot.");
-                    ai_chips += pot;
-                    current_state = GAME_STATE_ROUND_END;
-                }
+        btn_bet20.visible = btn_check.visible = btn_fold.visible = (game.state == PLAYER_TURN);
+        // tournament bets grow with the level, so those labels leave the amount off
+        if (tourney_mode) btn_bet20.text = game.to_call > 0 ? "Call" : "Bet";
+        else btn_bet20.text = game.to_call > 0 ? call_text : bet_text;
+        btn_check.enabled = game.to_call == 0;
+
+        if (game.state == PLAYER_TURN && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
+            Vector2 mp = GetMousePosition();
+            if (CheckCollisionPointRec(mp, btn_bet20.rect)) {
+                if (game.to_call > 0 && poker_act(&game, SEAT_PLAYER, ACTION_CALL)) add_to_log("You call.");
+                else if (poker_act(&game, SEAT_PLAYER, ACTION_BET)) add_to_log(TextFormat("You bet %d.", game.rules.bet_size));
+            } else if (CheckCollisionPointRec(mp, btn_check.rect)) {
+                if (poker_act(&game, SEAT_PLAYER, ACTION_CHECK)) add_to_log("You check.");
+            } else if (CheckCollisionPointRec(mp, btn_fold.rect)) {
+                add_to_log("You folded. AI wins the pot.");
+                poker_act(&game, SEAT_PLAYER, ACTION_FOLD);
             }
         }
 
-        if (current_state == GAME_STATE_AI_TURN_1) {
+        if (game.state == AI_TURN) {
             ai_action();
         }
 
-        if (current_state == GAME_STATE_PLAYER_DRAW) {
-            add_to_log("You draw 1 card (placeholder).");
-            player_hand[rand() % 5] = deal_card(&deck_stack);
-            current_state = GAME_STATE_AI_DRAW;
+        // draw phase: click cards to mark them, then draw (high draw odds are recounted on every click)
+        if (game.state == PLAYER_DRAW && !draw_odds_ready) {
+            discard_mask = 0;
+            if (game.rules.variant == VARIANT_DRAW_HIGH) odds_init(&draw_odds, game.hands[SEAT_PLAYER]);
+            draw_odds_ready = true;
         }
-
-        if (current_state == GAME_STATE_AI_DRAW) {
-            ai_draw_cards();
-            current_state = GAME_STATE_BETTING_2;
+        btn_draw.visible = game.state == PLAYER_DRAW;
+        if (draw_odds_ready) btn_draw.text = draw_labels[__builtin_popcount(discard_mask)];
+        if (game.state == PLAYER_DRAW && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
+            Vector2 mp = GetMousePosition();
+            for (int i = 0; i < HAND_SIZE; i++) {
+                float lift = (discard_mask >> i) & 1 ? DISCARD_LIFT : 0;
+                Rectangle card = { HAND_X + i * CARD_SPACING, PLAYER_HAND_Y - lift, CARD_W, CARD_H };
+                if (!CheckCollisionPointRec(mp, card)) continue;
+                discard_mask ^= 1u << i;
+                if (game.rules.variant == VARIANT_DRAW_HIGH) odds_toggle(&draw_odds, i);
+            }
+            if (CheckCollisionPointRec(mp, btn_draw.rect)) {
+                int drawn = poker_draw(&game, SEAT_PLAYER, discard_mask);
+                add_to_log(drawn ? TextFormat("You draw %d.", drawn) : "You stand pat.");
+                draw_odds_ready = false;
+            }
         }
 
-        if (current_state == GAME_STATE_AI_TURN_2) {
-            ai_action();
+        if (game.state == AI_DRAW) {
+            ai_draw_cards();
         }
 
-        if (current_state == GAME_STATE_SHOWDOWN) {
-            HandEvaluation p_eval = evaluate_hand(player_hand, 5);
-            HandEvaluation a_eval = evaluate_hand(ai_hand, 5);
-            int cmp = compare_hands(p_eval, a_eval);
-            if (cmp > 0) { add_to_log("You win the showdown!"); player_chips += pot; }
-            else if (cmp < 0) { add_to_log("AI wins the showdown!"); ai_chips += pot; }
-            else { add_to_log("It's a tie! Pot split."); player_chips += pot/2; ai_chips += pot/2; }
-            current_state = GAME_STATE_ROUND_END;
+        if (game.state == SHOWDOWN) {
+            showdown();
         }
 
         // DRAW
-        BeginDrawing();
-        ClearBackground((Color){0, 100, 0, 255});
-
-        if (current_state == GAME_STATE_MENU) {
-            DrawText("POKER GAME", 300, 200, 40, GOLD);
-            DrawText("Press ENTER to start", 290, 300, 20, WHITE);
-        } else {
-            draw_ui();
-        }
-
-        // Game log
-        for (int i = 0; i < log_count; i++)
-            DrawText(game_log[i], 50, 520 + i * 15, 14, LIGHTGRAY);
+        {
+            TRACE_SCOPE("draw_frame");
+            BeginDrawing();
+            ClearBackground((Color){0, 100, 0, 255});
+
+            if (show_menu) {
+                DrawText("POKER GAME", 300, 200, 40, GOLD);
+                DrawText("Press ENTER to start", 290, 300, 20, WHITE);
+                DrawText("Press T for a tournament", 275, 330, 20, WHITE);
+                for (int v = 0; v < NUM_VARIANTS; v++) {
+                    Color col = v == (int)game.rules.variant ? GOLD : LIGHTGRAY;
+                    DrawText(TextFormat("%d  %s", v + 1, variant_info((Variant)v)->name), 300, 380 + v * 20, 16, col);
+                }
+            } else {
+                draw_ui();
+                if (game.state == ROUND_END) DrawText("Press ENTER for the next round", 400, 340, 16, WHITE);
+            }
 
-        EndDrawing();
+            // Game log
+            for (int i = 0; i < log_count; i++)
+                DrawText(game_log[i], 50, 520 + i * 15, 14, LIGHTGRAY);
+        }
+        {
+            // EndDrawing swaps buffers and, with SetTargetFPS, waits out the frame
+            TRACE_SCOPE("end_drawing");
+            EndDrawing();
+        }
     }
 
+    stats_save(&opponent_stats, STATS_FILE);
+    TRACE_FLUSH();
+    unload_render_caches();
+    table_stream_close();
+    tourney_free(&tourney);
     CloseWindow();
     return 0;
 }
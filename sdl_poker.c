@@ -11,65 +11,70 @@
 #include <stdlib.h>
 #include <time.h>
 #include <string.h>
+#include "poker_core.h"
+#include "poker_stats.h"
+#include "poker_ai.h"
+#include "poker_tourney.h"
+#include "poker_variant.h"
+#include "trace.h"
+#include "asset_watch.h"
+#include "table_stream.h"
 
 #define WINDOW_WIDTH 1024
 #define WINDOW_HEIGHT 768
-#define DECK_SIZE 52
-#define HAND_SIZE 5
 #define CARD_WIDTH 80
 #define CARD_HEIGHT 120
 #define BUTTON_WIDTH 120
 #define BUTTON_HEIGHT 50
-
-/* Card Suits and Ranks */
-typedef enum {
-    HEARTS, DIAMONDS, CLUBS, SPADES
-} Suit;
-
-typedef enum {
-    TWO = 2, THREE, FOUR, FIVE, SIX, SEVEN, EIGHT, NINE, TEN, JACK, QUEEN, KING, ACE
-} Rank;
-
-/* Game States for State Machine */
-typedef enum {
-    START_ROUND,
-    PLAYER_TURN,
-    AI_TURN,
-    SHOWDOWN,
-    ROUND_END
-} GameState;
-
-/* Hand Rankings */
-typedef enum {
-    HIGH_CARD,
-    PAIR,
-    TWO_PAIR,
-    THREE_OF_KIND,
-    STRAIGHT,
-    FLUSH,
-    FULL_HOUSE,
-    FOUR_OF_KIND,
-    STRAIGHT_FLUSH
-} HandRank;
-
-/* Card Structure */
-typedef struct {
-    Suit suit;
-    Rank rank;
-    int value;
-} Card;
-
-/* Deck Structure - Contains array of 52 cards */
+#define BENCH_DEFAULT_FRAMES 600
+#define ASSET_DIR "res"
+#define STARTING_CHIPS 1000
+#define ANTE 10
+#define BET_SIZE 50
+#define STATS_FILE "opponent_stats.dat"
+#define PLAYER_STATS_ID 0
+#define TOURNEY_DEFAULT_PLAYERS 6
+#define TOURNEY_HUMAN 0
+
+/* Fixed-timestep game clock (seconds) */
+#define SIM_HZ 120
+#define SIM_DT (1.0 / SIM_HZ)
+#define MAX_FRAME_TIME 0.25
+#define FALLBACK_REFRESH_HZ 60
+
+/* State machine pauses, in game time */
+#define AI_THINK_TIME 1.0
+#define SHOWDOWN_DELAY 0.5
+
+/* Animation timings, in game time */
+#define DEAL_ANIM_TIME 0.30
+#define DEAL_STAGGER 0.08
+#define FLIP_ANIM_TIME 0.25
+#define FLIP_STAGGER 0.10
+#define CHIP_ANIM_TIME 0.45
+#define MAX_CHIP_ANIMS 8
+#define CHIP_SIZE 24
+
+/* Where cards are dealt from and where chips travel */
+#define DECK_X (WINDOW_WIDTH - CARD_WIDTH - 60)
+#define DECK_Y ((WINDOW_HEIGHT - CARD_HEIGHT) / 2)
+#define POT_X (WINDOW_WIDTH / 2)
+#define POT_Y (WINDOW_HEIGHT / 2)
+#define AI_CHIPS_Y 200
+#define PLAYER_CHIPS_Y 500
+
+/* Per-card animation timeline - start times are on the game clock, < 0 means none */
 typedef struct {
-    Card cards[DECK_SIZE];
-    int top;
-} Deck;
+    double deal_start;
+    double flip_start;
+} CardAnim;
 
-/* Hand Evaluation Result */
+/* Chip stack travelling between a player and the pot */
 typedef struct {
-    HandRank rank;
-    int high_value;
-} HandEval;
+    double start;
+    float from_x, from_y;
+    float to_x, to_y;
+} ChipAnim;
 
 /* Button Structure */
 typedef struct {
@@ -85,210 +90,57 @@ SDL_Texture* card_textures[DECK_SIZE];
 SDL_Texture* card_back_texture = NULL;
 SDL_Texture* table_texture = NULL;
 
-Deck deck;
-Card player_hand[HAND_SIZE];
-Card ai_hand[HAND_SIZE];
-int player_chips = 1000;
-int ai_chips = 1000;
-int pot = 0;
-GameState game_state = START_ROUND;
+/* Single betting round straight to showdown - --variant changes what wins, not the draws */
+const PokerRules sdl_rules = {STARTING_CHIPS, ANTE, BET_SIZE, 0, VARIANT_DRAW_HIGH};
+PokerGame game;
 int ai_revealed = 0;
 
-Button bet_button = {{50, 600, BUTTON_WIDTH, BUTTON_HEIGHT}, "BET 50", 1};
+/* What the AI has learned about the player, kept across sessions in STATS_FILE */
+StatsStore opponent_stats;
+
+/* --tournament: the player sits at table 0, the other tables are played by the core AI */
+Tournament tourney;
+int tourney_mode = 0;
+
+/* Game clock - advanced only by update_game() in SIM_DT steps */
+double game_time = 0.0;
+double prev_game_time = 0.0;
+double state_entered_at = 0.0;
+GameState timed_state = START_ROUND;
+
+CardAnim player_anims[HAND_SIZE];
+CardAnim ai_anims[HAND_SIZE];
+ChipAnim chip_anims[MAX_CHIP_ANIMS];
+
+/* Tournament levels raise the bet, so its label is rebuilt from the rules every round */
+char bet_label[16] = "BET";
+Button bet_button = {{50, 600, BUTTON_WIDTH, BUTTON_HEIGHT}, bet_label, 1};
 Button check_button = {{200, 600, BUTTON_WIDTH, BUTTON_HEIGHT}, "CHECK", 1};
 Button fold_button = {{350, 600, BUTTON_WIDTH, BUTTON_HEIGHT}, "FOLD", 1};
 
 /* Function Prototypes */
-void init_deck(Deck* d);
-void fisher_yates_shuffle(Deck* d);
-void deal_card(Deck* d, Card* hand, int index);
-int compare_cards(const void* a, const void* b);
-HandEval evaluate_hand(Card* hand);
-int compare_hands(HandEval h1, HandEval h2);
 SDL_Texture* load_texture(const char* path);
 void load_all_textures();
-void render_card(Card* c, int x, int y, int face_up);
-void render_hand(Card* hand, int y, int face_up);
+void apply_asset_reloads();
+void render_card(Card* c, float x, float y, float width_scale, int face_up);
+void render_hand(Card* hand, CardAnim* anims, int y, int face_up, double t);
+void render_chips(double t);
 void render_button(Button* btn);
 int is_point_in_button(int x, int y, Button* btn);
 void handle_player_action(const char* action);
+void observe_player(void* ctx, const PokerEvent* ev);
 void ai_decision();
 void showdown();
 void reset_round();
+int tourney_advance();
+void reveal_ai_hand();
+void start_chip_animation(float from_x, float from_y, float to_x, float to_y);
+void init_animations();
+void update_game();
+void render_frame(double alpha);
+int run_render_benchmark(int frames, int dump_every);
 void cleanup();
 
-/* Card suit/rank to string helpers */
-const char* suit_to_string(Suit s) {
-    switch(s) {
-        case HEARTS: return "H";
-        case DIAMONDS: return "D";
-        case CLUBS: return "C";
-        case SPADES: return "S";
-        default: return "?";
-    }
-}
-
-const char* rank_to_string(Rank r) {
-    switch(r) {
-        case TWO: return "2";
-        case THREE: return "3";
-        case FOUR: return "4";
-        case FIVE: return "5";
-        case SIX: return "6";
-        case SEVEN: return "7";
-        case EIGHT: return "8";
-        case NINE: return "9";
-        case TEN: return "10";
-        case JACK: return "J";
-        case QUEEN: return "Q";
-        case KING: return "K";
-        case ACE: return "A";
-        default: return "?";
-    }
-}
-
-/* Initialize deck with 52 cards using array */
-void init_deck(Deck* d) {
-    int index = 0;
-    for (int suit = HEARTS; suit <= SPADES; suit++) {
-        for (int rank = TWO; rank <= ACE; rank++) {
-            d->cards[index].suit = suit;
-            d->cards[index].rank = rank;
-            d->cards[index].value = rank;
-            index++;
-        }
-    }
-    d->top = 0;
-}
-
-/* Fisher-Yates Shuffle Algorithm */
-void fisher_yates_shuffle(Deck* d) {
-    for (int i = DECK_SIZE - 1; i > 0; i--) {
-        int j = rand() % (i + 1);
-        Card temp = d->cards[i];
-        d->cards[i] = d->cards[j];
-        d->cards[j] = temp;
-    }
-    d->top = 0;
-}
-
-/* Deal a card from deck to hand */
-void deal_card(Deck* d, Card* hand, int index) {
-    if (d->top < DECK_SIZE) {
-        hand[index] = d->cards[d->top++];
-    }
-}
-
-/* Comparison function for qsort - sorts by rank */
-int compare_cards(const void* a, const void* b) {
-    Card* card_a = (Card*)a;
-    Card* card_b = (Card*)b;
-    return card_a->value - card_b->value;
-}
-
-/* Count occurrences of each rank using counting algorithm */
-void count_ranks(Card* hand, int counts[13]) {
-    memset(counts, 0, 13 * sizeof(int));
-    for (int i = 0; i < HAND_SIZE; i++) {
-        counts[hand[i].rank - 2]++;
-    }
-}
-
-/* Check if hand is a flush */
-int is_flush(Card* hand) {
-    Suit first = hand[0].suit;
-    for (int i = 1; i < HAND_SIZE; i++) {
-        if (hand[i].suit != first) return 0;
-    }
-    return 1;
-}
-
-/* Check if hand is a straight (hand must be sorted) */
-int is_straight(Card* hand) {
-    for (int i = 0; i < HAND_SIZE - 1; i++) {
-        if (hand[i+1].value != hand[i].value + 1) {
-            return 0;
-        }
-    }
-    return 1;
-}
-
-/* Evaluate hand using sorting and counting algorithms */
-HandEval evaluate_hand(Card* hand) {
-    HandEval result = {HIGH_CARD, 0};
-    Card sorted[HAND_SIZE];
-    memcpy(sorted, hand, HAND_SIZE * sizeof(Card));
-    
-    /* Sort cards using qsort */
-    qsort(sorted, HAND_SIZE, sizeof(Card), compare_cards);
-    
-    /* Count ranks using counting algorithm */
-    int counts[13];
-    count_ranks(sorted, counts);
-    
-    int pairs = 0, threes = 0, fours = 0;
-    int high = 0;
-    
-    for (int i = 0; i < 13; i++) {
-        if (counts[i] == 4) {
-            fours = 1;
-            high = i + 2;
-        } else if (counts[i] == 3) {
-            threes = 1;
-            high = i + 2;
-        } else if (counts[i] == 2) {
-            pairs++;
-            high = i + 2;
-        } else if (counts[i] == 1 && high == 0) {
-            high = i + 2;
-        }
-    }
-    
-    int flush = is_flush(sorted);
-    int straight = is_straight(sorted);
-    
-    /* Determine hand rank */
-    if (straight && flush) {
-        result.rank = STRAIGHT_FLUSH;
-        result.high_value = sorted[4].value;
-    } else if (fours) {
-        result.rank = FOUR_OF_KIND;
-        result.high_value = high;
-    } else if (threes && pairs == 1) {
-        result.rank = FULL_HOUSE;
-        result.high_value = high;
-    } else if (flush) {
-        result.rank = FLUSH;
-        result.high_value = sorted[4].value;
-    } else if (straight) {
-        result.rank = STRAIGHT;
-        result.high_value = sorted[4].value;
-    } else if (threes) {
-        result.rank = THREE_OF_KIND;
-        result.high_value = high;
-    } else if (pairs == 2) {
-        result.rank = TWO_PAIR;
-        result.high_value = high;
-    } else if (pairs == 1) {
-        result.rank = PAIR;
-        result.high_value = high;
-    } else {
-        result.rank = HIGH_CARD;
-        result.high_value = sorted[4].value;
-    }
-    
-    return result;
-}
-
-/* Compare two hands - returns 1 if h1 wins, -1 if h2 wins, 0 for tie */
-int compare_hands(HandEval h1, HandEval h2) {
-    if (h1.rank > h2.rank) return 1;
-    if (h1.rank < h2.rank) return -1;
-    if (h1.high_value > h2.high_value) return 1;
-    if (h1.high_value < h2.high_value) return -1;
-    return 0;
-}
-
 /* Load texture from file path */
 SDL_Texture* load_texture(const char* path) {
     SDL_Surface* surface = IMG_Load(path);
@@ -303,6 +155,7 @@ SDL_Texture* load_texture(const char* path) {
 
 /* Load all card textures and table background */
 void load_all_textures() {
+    TRACE_SCOPE("load_all_textures");
     /* Load card back */
     card_back_texture = load_texture("res/card_back.png");
     
@@ -323,32 +176,150 @@ void load_all_textures() {
     }
 }
 
-/* Get texture index for a card */
+/* Swap in textures whose files changed on disk - call between frames */
+void apply_asset_reloads() {
+    AssetReload reloads[ASSET_MAX_PENDING];
+    int count = asset_watch_poll(reloads, ASSET_MAX_PENDING);
+    if (count == 0) return;
+    
+    TRACE_SCOPE("apply_asset_reloads");
+    for (int i = 0; i < count; i++) {
+        /* Work out which texture slot the file belongs to */
+        SDL_Texture** slot = NULL;
+        if (strcmp(reloads[i].name, "card_back.png") == 0) {
+            slot = &card_back_texture;
+        } else if (strcmp(reloads[i].name, "table.png") == 0) {
+            slot = &table_texture;
+        } else {
+            for (int suit = HEARTS; suit <= SPADES && !slot; suit++) {
+                for (int rank = TWO; rank <= ACE; rank++) {
+                    char name[ASSET_NAME_LEN];
+                    snprintf(name, sizeof(name), "%s%s.png", suit_to_string(suit), rank_to_string(rank));
+                    if (strcmp(reloads[i].name, name) == 0) {
+                        slot = &card_textures[suit * 13 + (rank - 2)];
+                        break;
+                    }
+                }
+            }
+        }
+        
+        /* The old texture stays in place if the new one can't be created */
+        SDL_Texture* texture = slot ? SDL_CreateTextureFromSurface(renderer, reloads[i].surface) : NULL;
+        if (texture) {
+            if (*slot) SDL_DestroyTexture(*slot);
+            *slot = texture;
+            printf("Reloaded %s/%s\n", ASSET_DIR, reloads[i].name);
+        }
+        SDL_FreeSurface(reloads[i].surface);
+    }
+}
+
+/* Get texture index for a card - -1 for a joker, which has no face of its own */
 int get_card_texture_index(Card* c) {
+    if (c->rank == JOKER) return -1;
     return (c->suit * 13) + (c->rank - 2);
 }
 
-/* Render a single card */
-void render_card(Card* c, int x, int y, int face_up) {
-    SDL_Rect dest = {x, y, CARD_WIDTH, CARD_HEIGHT};
+/* Normalised progress of an animation at time t: 0 before start, 1 when done */
+double anim_progress(double t, double start, double duration) {
+    if (start < 0.0 || t <= start) return 0.0;
+    if (t >= start + duration) return 1.0;
+    return (t - start) / duration;
+}
+
+/* Cubic ease-out - fast start, gentle landing */
+double ease_out_cubic(double p) {
+    double inv = 1.0 - p;
+    return 1.0 - inv * inv * inv;
+}
+
+/* Render a single card, squeezed horizontally about its centre by width_scale */
+void render_card(Card* c, float x, float y, float width_scale, int face_up) {
+    float w = CARD_WIDTH * width_scale;
+    SDL_FRect dest = {x + (CARD_WIDTH - w) / 2.0f, y, w, CARD_HEIGHT};
     
-    if (face_up) {
+    if (face_up && c->rank == JOKER) {
+        /* Jokers show as a gold-tinted card back */
+        if (card_back_texture) {
+            SDL_SetTextureColorMod(card_back_texture, 255, 200, 60);
+            SDL_RenderCopyF(renderer, card_back_texture, NULL, &dest);
+            SDL_SetTextureColorMod(card_back_texture, 255, 255, 255);
+        }
+    } else if (face_up) {
         int index = get_card_texture_index(c);
         if (card_textures[index]) {
-            SDL_RenderCopy(renderer, card_textures[index], NULL, &dest);
+            SDL_RenderCopyF(renderer, card_textures[index], NULL, &dest);
         }
     } else {
         if (card_back_texture) {
-            SDL_RenderCopy(renderer, card_back_texture, NULL, &dest);
+            SDL_RenderCopyF(renderer, card_back_texture, NULL, &dest);
         }
     }
 }
 
-/* Render a hand of 5 cards */
-void render_hand(Card* hand, int y, int face_up) {
+/* Render a hand of 5 cards at game time t, sliding in from the deck and flipping over */
+void render_hand(Card* hand, CardAnim* anims, int y, int face_up, double t) {
     int start_x = (WINDOW_WIDTH - (HAND_SIZE * CARD_WIDTH + 4 * 20)) / 2;
     for (int i = 0; i < HAND_SIZE; i++) {
-        render_card(&hand[i], start_x + i * (CARD_WIDTH + 20), y, face_up);
+        double e = 1.0;
+        if (anims[i].deal_start >= 0.0) {
+            double deal = anim_progress(t, anims[i].deal_start, DEAL_ANIM_TIME);
+            if (deal <= 0.0) continue;  /* Still in the deck */
+            e = ease_out_cubic(deal);
+        }
+        
+        float slot_x = start_x + i * (CARD_WIDTH + 20);
+        float x = DECK_X + (slot_x - DECK_X) * e;
+        float card_y = DECK_Y + (y - DECK_Y) * e;
+        
+        /* Flip shrinks the back to nothing, then grows the face back out */
+        float width_scale = 1.0f;
+        int show_face = face_up;
+        if (face_up && anims[i].flip_start >= 0.0) {
+            double flip = anim_progress(t, anims[i].flip_start, FLIP_ANIM_TIME);
+            show_face = flip >= 0.5;
+            width_scale = (float)(flip < 0.5 ? 1.0 - 2.0 * flip : 2.0 * flip - 1.0);
+        }
+        
+        render_card(&hand[i], x, card_y, width_scale, show_face);
+    }
+}
+
+/* Render chip stacks in flight at game time t */
+void render_chips(double t) {
+    for (int i = 0; i < MAX_CHIP_ANIMS; i++) {
+        ChipAnim* a = &chip_anims[i];
+        double p = anim_progress(t, a->start, CHIP_ANIM_TIME);
+        if (p <= 0.0 || p >= 1.0) continue;
+        
+        double e = ease_out_cubic(p);
+        float x = a->from_x + (a->to_x - a->from_x) * e - CHIP_SIZE / 2.0f;
+        float y = a->from_y + (a->to_y - a->from_y) * e - CHIP_SIZE / 2.0f;
+        
+        /* Three-chip stack */
+        for (int c = 0; c < 3; c++) {
+            SDL_FRect chip = {x, y - c * 4.0f, CHIP_SIZE, CHIP_SIZE};
+            SDL_SetRenderDrawColor(renderer, 218, 165, 32, 255);
+            SDL_RenderFillRectF(renderer, &chip);
+            SDL_FRect inner = {chip.x + 4, chip.y + 4, CHIP_SIZE - 8, CHIP_SIZE - 8};
+            SDL_SetRenderDrawColor(renderer, 255, 215, 0, 255);
+            SDL_RenderFillRectF(renderer, &inner);
+        }
+    }
+}
+
+/* Launch a chip stack from one point to another, reusing a finished slot */
+void start_chip_animation(float from_x, float from_y, float to_x, float to_y) {
+    for (int i = 0; i < MAX_CHIP_ANIMS; i++) {
+        ChipAnim* a = &chip_anims[i];
+        if (anim_progress(game_time, a->start, CHIP_ANIM_TIME) >= 1.0 || a->start < 0.0) {
+            a->start = game_time;
+            a->from_x = from_x;
+            a->from_y = from_y;
+            a->to_x = to_x;
+            a->to_y = to_y;
+            return;
+        }
     }
 }
 
@@ -372,86 +343,370 @@ int is_point_in_button(int x, int y, Button* btn) {
            y >= btn->rect.y && y <= btn->rect.y + btn->rect.h;
 }
 
-/* Handle player's action */
+/* Handle player's action - BET calls instead when the AI has bet */
 void handle_player_action(const char* action) {
+    Action a = ACTION_CHECK;
     if (strcmp(action, "BET") == 0) {
-        if (player_chips >= 50) {
-            player_chips -= 50;
-            pot += 50;
-            game_state = AI_TURN;
-        }
-    } else if (strcmp(action, "CHECK") == 0) {
-        game_state = AI_TURN;
+        a = game.to_call > 0 ? ACTION_CALL : ACTION_BET;
     } else if (strcmp(action, "FOLD") == 0) {
-        ai_chips += pot;
-        pot = 0;
-        game_state = ROUND_END;
+        a = ACTION_FOLD;
     }
+    
+    if (!poker_act(&game, SEAT_PLAYER, a)) return;
+    
+    if (a == ACTION_FOLD) {
+        start_chip_animation(POT_X, POT_Y, POT_X, AI_CHIPS_Y);
+    } else if (a != ACTION_CHECK) {
+        start_chip_animation(POT_X, PLAYER_CHIPS_Y, POT_X, POT_Y);
+    }
+}
+
+/* Feed every game event into the player's running stats, and out to the table stream if open */
+void observe_player(void* ctx, const PokerEvent* ev) {
+    stats_observe((OpponentStats*)ctx, SEAT_PLAYER, ev);
+    table_stream_publish(&game, ev);
 }
 
-/* Simple AI decision logic */
+/* AI decision - shared core AI, reading what it knows about the player */
 void ai_decision() {
-    /* AI simply calls or checks */
-    if (pot > 20) {  /* If player bet */
-        if (ai_chips >= 50) {
-            ai_chips -= 50;
-            pot += 50;
-        }
+    TRACE_SCOPE("ai_decision");
+    OpponentStats* opp = stats_get(&opponent_stats, PLAYER_STATS_ID);
+    Action a;
+    StreamCommand cmd;
+    if (table_stream_bot(&game, SEAT_AI)) {
+        /* A bot on the table stream has the seat - keep waiting until it answers */
+        if (!table_stream_poll(SEAT_AI, &cmd) || cmd.kind != STREAM_CMD_ACT) return;
+        a = (Action)cmd.action;
+    } else if (tourney_mode) {
+        IcmSpot spot;
+        tourney_spot(&tourney, 0, &spot);
+        a = ai_choose_tournament_action(&game, SEAT_AI, opp, &spot);
+    } else {
+        a = ai_choose_action(&game, SEAT_AI, opp);
+    }
+    if (!poker_act(&game, SEAT_AI, a)) return;
+    
+    if (a == ACTION_FOLD) {
+        start_chip_animation(POT_X, POT_Y, POT_X, PLAYER_CHIPS_Y);
+        printf("AI folds.\n");
+    } else if (a != ACTION_CHECK) {
+        start_chip_animation(POT_X, AI_CHIPS_Y, POT_X, POT_Y);
     }
-    game_state = SHOWDOWN;
 }
 
 /* Showdown - reveal hands and determine winner */
 void showdown() {
-    ai_revealed = 1;
-    
-    HandEval player_eval = evaluate_hand(player_hand);
-    HandEval ai_eval = evaluate_hand(ai_hand);
+    TRACE_SCOPE("showdown");
+    reveal_ai_hand();
+    poker_showdown(&game);
     
-    int result = compare_hands(player_eval, ai_eval);
-    
-    if (result > 0) {
-        player_chips += pot;
-        printf("Player wins with hand rank %d!\n", player_eval.rank);
-    } else if (result < 0) {
-        ai_chips += pot;
-        printf("AI wins with hand rank %d!\n", ai_eval.rank);
+    if (game.winner == SEAT_PLAYER) {
+        start_chip_animation(POT_X, POT_Y, POT_X, PLAYER_CHIPS_Y);
+        printf("Player wins with %s!\n", hand_rank_to_string(game.evals[SEAT_PLAYER].rank));
+    } else if (game.winner == SEAT_AI) {
+        start_chip_animation(POT_X, POT_Y, POT_X, AI_CHIPS_Y);
+        printf("AI wins with %s!\n", hand_rank_to_string(game.evals[SEAT_AI].rank));
     } else {
-        player_chips += pot / 2;
-        ai_chips += pot / 2;
+        start_chip_animation(POT_X, POT_Y, POT_X, PLAYER_CHIPS_Y);
+        start_chip_animation(POT_X, POT_Y, POT_X, AI_CHIPS_Y);
         printf("Tie!\n");
     }
+}
+
+/*
+ * Tournament mode: settle the hand just played at the player's table,
+ * play one hand at every other table, then seat the next hand. Returns 0
+ * (leaving the game over) once the player has busted or won.
+ */
+int tourney_advance() {
+    TRACE_SCOPE("tourney_advance");
+    if (game.state == ROUND_END) {
+        int alive = tourney.alive;
+        int level = tourney.level;
+        tourney_store_table(&tourney, 0, &game);
+        for (int table = 1; table < tourney.num_tables; table++) {
+            tourney_play_table(&tourney, table);
+        }
+        tourney_finish_hand(&tourney);
+        
+        if (tourney.alive != alive) {
+            printf("%d players left.\n", tourney.alive);
+        }
+        if (tourney.level != level) {
+            printf("Level %d - ante %d, bet %d.\n", tourney.level + 1,
+                   tourney.cfg.levels[tourney.level].ante, tourney.cfg.levels[tourney.level].bet_size);
+        }
+    }
+    
+    int place = tourney.place[TOURNEY_HUMAN];
+    if (place != 0) {
+        printf("Tournament over - you finished %d of %d and won %.0f%% of the prize pool.\n",
+               place, tourney.cfg.players, tourney_prize(&tourney, TOURNEY_HUMAN) * 100.0);
+        game.state = GAME_OVER;
+        return 0;
+    }
     
-    pot = 0;
-    game_state = ROUND_END;
+    tourney_seat(&tourney);
+    tourney_load_table(&tourney, 0, &game);
+    return 1;
 }
 
 /* Reset for new round */
 void reset_round() {
+    TRACE_SCOPE("reset_round");
     ai_revealed = 0;
-    pot = 0;
     
-    /* Ante */
-    if (player_chips >= 10 && ai_chips >= 10) {
-        player_chips -= 10;
-        ai_chips -= 10;
-        pot = 20;
-    }
+    if (tourney_mode && !tourney_advance()) return;
     
-    /* Shuffle and deal */
-    init_deck(&deck);
-    fisher_yates_shuffle(&deck);
+    /* Ante, shuffle and deal */
+    if (!poker_start_round(&game)) {
+        printf("Game over - %s cannot pay the ante.\n",
+               game.chips[SEAT_PLAYER] < game.rules.ante ? "player" : "AI");
+        return;
+    }
+    snprintf(bet_label, sizeof(bet_label), "BET %d", game.rules.bet_size);
     
+    /* Deal alternately, each card sliding out of the deck a little after the last */
+    for (int i = 0; i < HAND_SIZE; i++) {
+        player_anims[i].deal_start = game_time + (2 * i) * DEAL_STAGGER;
+        player_anims[i].flip_start = -1.0;
+        ai_anims[i].deal_start = game_time + (2 * i + 1) * DEAL_STAGGER;
+        ai_anims[i].flip_start = -1.0;
+    }
+}
+
+/* Turn the AI hand face up, one card after another */
+void reveal_ai_hand() {
+    if (ai_revealed) return;
+    ai_revealed = 1;
+    for (int i = 0; i < HAND_SIZE; i++) {
+        ai_anims[i].flip_start = game_time + i * FLIP_STAGGER;
+    }
+}
+
+/* Clear every card and chip animation */
+void init_animations() {
     for (int i = 0; i < HAND_SIZE; i++) {
-        deal_card(&deck, player_hand, i);
-        deal_card(&deck, ai_hand, i);
+        player_anims[i].deal_start = player_anims[i].flip_start = -1.0;
+        ai_anims[i].deal_start = ai_anims[i].flip_start = -1.0;
+    }
+    for (int i = 0; i < MAX_CHIP_ANIMS; i++) {
+        chip_anims[i].start = -1.0;
+    }
+}
+
+/* Advance the game clock by one fixed step and run timed state transitions */
+void update_game() {
+    TRACE_SCOPE("update_game");
+    prev_game_time = game_time;
+    game_time += SIM_DT;
+    
+    if (game.state != timed_state) {
+        timed_state = game.state;
+        state_entered_at = game_time;
+    }
+    
+    /* Pauses are measured on the game clock instead of blocking the loop */
+    double in_state = game_time - state_entered_at;
+    if (game.state == AI_TURN && in_state >= AI_THINK_TIME) {
+        ai_decision();
+    } else if (game.state == SHOWDOWN && in_state >= SHOWDOWN_DELAY) {
+        showdown();
+    }
+}
+
+/*
+ * Render one frame of the table, both hands and the action buttons.
+ * alpha is how far (0..1) the wall clock has run past the last game tick;
+ * animations are sampled between the previous and current tick by it.
+ */
+void render_frame(double alpha) {
+    TRACE_SCOPE("render_frame");
+    double t = prev_game_time + (game_time - prev_game_time) * alpha;
+    
+    {
+        TRACE_SCOPE("render_table");
+        SDL_SetRenderDrawColor(renderer, 0, 100, 0, 255);
+        SDL_RenderClear(renderer);
+        
+        /* Render table background if loaded */
+        if (table_texture) {
+            SDL_RenderCopy(renderer, table_texture, NULL, NULL);
+        }
+        
+        /* Render the deck the cards are dealt from */
+        render_card(NULL, DECK_X, DECK_Y, 1.0f, 0);
+    }
+    
+    {
+        TRACE_SCOPE("render_hands");
+        
+        /* Render AI hand (top) */
+        render_hand(game.hands[SEAT_AI], ai_anims, 50, ai_revealed, t);
+        
+        /* Render player hand (bottom) */
+        render_hand(game.hands[SEAT_PLAYER], player_anims, 550, 1, t);
+    }
+    
+    {
+        TRACE_SCOPE("render_chips");
+        render_chips(t);
+    }
+    
+    /* Render buttons during player turn */
+    if (game.state == PLAYER_TURN) {
+        TRACE_SCOPE("render_buttons");
+        render_button(&bet_button);
+        render_button(&check_button);
+        render_button(&fold_button);
+    }
+}
+
+/* Scripted stretch of frames for the render benchmark */
+typedef struct {
+    GameState state;
+    int ai_revealed;
+    int new_deal;
+    int frames;
+} BenchStep;
+
+/* One hand played through every visible state, repeated for the whole run */
+static const BenchStep bench_script[] = {
+    {PLAYER_TURN, 0, 1, 60},   /* Deal animation, then the action buttons */
+    {AI_TURN, 0, 0, 30},
+    {SHOWDOWN, 1, 0, 60},      /* AI hand flips over */
+    {ROUND_END, 1, 0, 30}
+};
+
+/* Comparison function for qsort - sorts frame times ascending */
+static int compare_frame_times(const void* a, const void* b) {
+    double da = *(const double*)a;
+    double db = *(const double*)b;
+    return (da > db) - (da < db);
+}
+
+/* Nearest-rank percentile of a sorted sample */
+static double percentile(const double* sorted, int count, double pct) {
+    int index = (int)(pct / 100.0 * count + 0.5) - 1;
+    if (index < 0) index = 0;
+    if (index >= count) index = count - 1;
+    return sorted[index];
+}
+
+/*
+ * Headless render benchmark - replays bench_script through render_frame()
+ * on the software renderer, drawing into an offscreen surface. Runs under
+ * the dummy video driver so it needs neither a display nor a GPU.
+ * Every dump_every-th frame is written to bench_NNNNN.png (0 disables).
+ */
+int run_render_benchmark(int frames, int dump_every) {
+    SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+    
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+        printf("SDL init failed: %s\n", SDL_GetError());
+        return 1;
+    }
+    
+    if (!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) {
+        printf("SDL_image init failed: %s\n", IMG_GetError());
+        SDL_Quit();
+        return 1;
+    }
+    
+    SDL_Surface* target = SDL_CreateRGBSurfaceWithFormat(0, WINDOW_WIDTH, WINDOW_HEIGHT,
+                                                         32, SDL_PIXELFORMAT_ARGB8888);
+    double* frame_ms = malloc(frames * sizeof(double));
+    if (!target || !frame_ms) {
+        printf("Offscreen target creation failed: %s\n", SDL_GetError());
+        free(frame_ms);
+        if (target) SDL_FreeSurface(target);
+        IMG_Quit();
+        SDL_Quit();
+        return 1;
+    }
+    
+    renderer = SDL_CreateSoftwareRenderer(target);
+    if (!renderer) {
+        printf("Renderer creation failed: %s\n", SDL_GetError());
+        free(frame_ms);
+        SDL_FreeSurface(target);
+        IMG_Quit();
+        SDL_Quit();
+        return 1;
     }
     
-    game_state = PLAYER_TURN;
+    load_all_textures();
+    init_animations();
+    poker_game_init(&game, &sdl_rules, 1);
+    
+    int script_len = sizeof(bench_script) / sizeof(bench_script[0]);
+    int step_index = -1;
+    int step_frames_left = 0;
+    double ticks_to_ms = 1000.0 / SDL_GetPerformanceFrequency();
+    double total_ms = 0.0;
+    
+    for (int frame = 0; frame < frames; frame++) {
+        if (step_frames_left == 0) {
+            step_index = (step_index + 1) % script_len;
+            const BenchStep* step = &bench_script[step_index];
+            step_frames_left = step->frames;
+            if (step->new_deal) {
+                /* Fresh stacks for every scripted hand so the run never hits game over */
+                poker_game_init(&game, &sdl_rules, 1 + frame);
+                reset_round();
+            }
+            if (step->ai_revealed) {
+                reveal_ai_hand();
+            }
+            game.state = step->state;
+        }
+        step_frames_left--;
+        
+        /* The game clock runs at a fixed 60 Hz here so every run animates identically */
+        prev_game_time = game_time;
+        game_time += 1.0 / 60.0;
+        
+        Uint64 start = SDL_GetPerformanceCounter();
+        render_frame(1.0);
+        {
+            TRACE_SCOPE("render_flush");
+            SDL_RenderFlush(renderer);
+        }
+        Uint64 end = SDL_GetPerformanceCounter();
+        
+        frame_ms[frame] = (end - start) * ticks_to_ms;
+        total_ms += frame_ms[frame];
+        
+        if (dump_every > 0 && frame % dump_every == 0) {
+            char path[64];
+            snprintf(path, sizeof(path), "bench_%05d.png", frame);
+            if (IMG_SavePNG(target, path) != 0) {
+                printf("Failed to save frame %s: %s\n", path, IMG_GetError());
+            }
+        }
+    }
+    
+    qsort(frame_ms, frames, sizeof(double), compare_frame_times);
+    printf("Rendered %d frames (software renderer, %dx%d)\n", frames, WINDOW_WIDTH, WINDOW_HEIGHT);
+    printf("  mean %.3f ms  min %.3f ms  max %.3f ms\n",
+           total_ms / frames, frame_ms[0], frame_ms[frames - 1]);
+    printf("  p50 %.3f ms  p95 %.3f ms  p99 %.3f ms\n",
+           percentile(frame_ms, frames, 50.0),
+           percentile(frame_ms, frames, 95.0),
+           percentile(frame_ms, frames, 99.0));
+    
+    free(frame_ms);
+    cleanup();
+    SDL_FreeSurface(target);
+    return 0;
 }
 
 /* Cleanup SDL resources */
 void cleanup() {
+    /* Join the watcher thread first - the trace can only be flushed once it has stopped */
+    asset_watch_stop();
+    table_stream_close();
+    tourney_free(&tourney);
     for (int i = 0; i < DECK_SIZE; i++) {
         if (card_textures[i]) SDL_DestroyTexture(card_textures[i]);
     }
@@ -461,11 +716,80 @@ void cleanup() {
     if (window) SDL_DestroyWindow(window);
     IMG_Quit();
     SDL_Quit();
+    
+    /* Write out the profiling trace (no-op unless built with POKER_TRACE) - no other thread is left */
+    TRACE_FLUSH();
 }
 
 /* Main function */
 int main(int argc, char* argv[]) {
-    srand(time(NULL));
+    TRACE_THREAD_NAME("main");
+    
+    /* --bench [frames] [--dump-every N] runs the headless render benchmark */
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        int frames = BENCH_DEFAULT_FRAMES;
+        int dump_every = 0;
+        for (int i = 2; i < argc; i++) {
+            if (strcmp(argv[i], "--dump-every") == 0 && i + 1 < argc) {
+                dump_every = atoi(argv[++i]);
+            } else if (atoi(argv[i]) > 0) {
+                frames = atoi(argv[i]);
+            }
+        }
+        return run_render_benchmark(frames, dump_every);
+    }
+    
+    /*
+     * --watch reloads res/ images as they change on disk; --tournament [players] plays a freezeout;
+     * --variant key (draw, 27, a5, deuces, joker) picks the game
+     */
+    int watch_assets = 0;
+    int variant = VARIANT_DRAW_HIGH;
+    int tourney_players = TOURNEY_DEFAULT_PLAYERS;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--watch") == 0) {
+            watch_assets = 1;
+        } else if (strcmp(argv[i], "--tournament") == 0) {
+            tourney_mode = 1;
+            if (i + 1 < argc && atoi(argv[i + 1]) > 0) {
+                tourney_players = atoi(argv[++i]);
+            }
+        } else if (strcmp(argv[i], "--variant") == 0 && i + 1 < argc) {
+            variant = variant_from_key(argv[++i]);
+            if (variant < 0) {
+                printf("Unknown variant %s\n", argv[i]);
+                return 1;
+            }
+        }
+    }
+    
+    uint64_t seed = (uint64_t)time(NULL);
+    poker_game_init(&game, &sdl_rules, seed);
+    game.rules.variant = (Variant)variant;
+    printf("Playing %s\n", variant_info(game.rules.variant)->name);
+    stats_init(&opponent_stats);
+    stats_load(&opponent_stats, STATS_FILE);
+    poker_set_observer(&game, observe_player, stats_get(&opponent_stats, PLAYER_STATS_ID));
+    
+    /* POKER_STREAM=1 (or a shm name) publishes the table for table_watch, and bots may take the AI seat */
+    const char* stream_name = getenv("POKER_STREAM");
+    if (stream_name && *stream_name) {
+        table_stream_open(strcmp(stream_name, "1") == 0 ? STREAM_DEFAULT_NAME : stream_name, 1u << SEAT_AI);
+    }
+    
+    if (tourney_mode) {
+        TourneyConfig cfg;
+        tourney_default_config(&cfg, tourney_players, STARTING_CHIPS);
+        cfg.draw_rounds = sdl_rules.draw_rounds;
+        cfg.variant = game.rules.variant;
+        cfg.human = TOURNEY_HUMAN;
+        if (!tourney_init(&tourney, &cfg, seed + 1)) {
+            printf("Failed to set up the tournament\n");
+            return 1;
+        }
+        printf("Tournament: %d players, %d paid, antes rise every %d hands.\n",
+               cfg.players, cfg.paid, cfg.hands_per_level);
+    }
     
     /* Initialize SDL */
     if (SDL_Init(SDL_INIT_VIDEO) < 0) {
@@ -493,8 +817,8 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     
-    /* Create renderer */
-    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+    /* Create renderer - present waits for vblank where the driver supports it */
+    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
     if (!renderer) {
         printf("Renderer creation failed: %s\n", SDL_GetError());
         SDL_DestroyWindow(window);
@@ -505,15 +829,39 @@ int main(int argc, char* argv[]) {
     
     /* Load all textures */
     load_all_textures();
+    if (watch_assets) {
+        asset_watch_start(ASSET_DIR);
+    }
     
     /* Start first round */
+    init_animations();
     reset_round();
     
+    /* Without vsync, sleep out the rest of each display refresh ourselves */
+    SDL_RendererInfo info;
+    int vsync = SDL_GetRendererInfo(renderer, &info) == 0 && (info.flags & SDL_RENDERER_PRESENTVSYNC);
+    SDL_DisplayMode mode;
+    int refresh_hz = FALLBACK_REFRESH_HZ;
+    if (SDL_GetCurrentDisplayMode(SDL_GetWindowDisplayIndex(window), &mode) == 0 && mode.refresh_rate > 0) {
+        refresh_hz = mode.refresh_rate;
+    }
+    
     /* Main game loop - State Machine */
     int running = 1;
     SDL_Event event;
+    Uint64 ticks_per_sec = SDL_GetPerformanceFrequency();
+    Uint64 last_frame = SDL_GetPerformanceCounter();
+    double accumulator = 0.0;
     
     while (running) {
+        Uint64 frame_start = SDL_GetPerformanceCounter();
+        double frame_time = (double)(frame_start - last_frame) / ticks_per_sec;
+        last_frame = frame_start;
+        
+        /* Cap huge gaps (window drags, breakpoints) so we don't replay seconds of ticks */
+        if (frame_time > MAX_FRAME_TIME) frame_time = MAX_FRAME_TIME;
+        accumulator += frame_time;
+        
         /* Handle events */
         while (SDL_PollEvent(&event)) {
             if (event.type == SDL_QUIT) {
@@ -522,7 +870,7 @@ int main(int argc, char* argv[]) {
                 int x = event.button.x;
                 int y = event.button.y;
                 
-                if (game_state == PLAYER_TURN) {
+                if (game.state == PLAYER_TURN) {
                     if (is_point_in_button(x, y, &bet_button)) {
                         handle_player_action("BET");
                     } else if (is_point_in_button(x, y, &check_button)) {
@@ -530,52 +878,42 @@ int main(int argc, char* argv[]) {
                     } else if (is_point_in_button(x, y, &fold_button)) {
                         handle_player_action("FOLD");
                     }
-                } else if (game_state == ROUND_END) {
+                } else if (game.state == ROUND_END) {
                     /* Click anywhere to start new round */
                     reset_round();
                 }
             } else if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_SPACE) {
-                if (game_state == ROUND_END) {
+                if (game.state == ROUND_END) {
                     reset_round();
                 }
             }
         }
         
-        /* State machine updates */
-        if (game_state == AI_TURN) {
-            SDL_Delay(1000);  /* Pause for AI "thinking" */
-            ai_decision();
-        } else if (game_state == SHOWDOWN) {
-            SDL_Delay(500);
-            showdown();
-        }
+        /* Swap in any images rewritten since the last frame */
+        apply_asset_reloads();
         
-        /* Render */
-        SDL_SetRenderDrawColor(renderer, 0, 100, 0, 255);
-        SDL_RenderClear(renderer);
-        
-        /* Render table background if loaded */
-        if (table_texture) {
-            SDL_RenderCopy(renderer, table_texture, NULL, NULL);
+        /* State machine updates - as many fixed steps as wall time has covered */
+        while (accumulator >= SIM_DT) {
+            update_game();
+            accumulator -= SIM_DT;
         }
         
-        /* Render AI hand (top) */
-        render_hand(ai_hand, 50, ai_revealed);
-        
-        /* Render player hand (bottom) */
-        render_hand(player_hand, 550, 1);
-        
-        /* Render buttons during player turn */
-        if (game_state == PLAYER_TURN) {
-            render_button(&bet_button);
-            render_button(&check_button);
-            render_button(&fold_button);
+        render_frame(accumulator / SIM_DT);
+        {
+            TRACE_SCOPE("present");
+            SDL_RenderPresent(renderer);
         }
         
-        SDL_RenderPresent(renderer);
-        SDL_Delay(16);  /* ~60 FPS */
+        if (!vsync) {
+            double elapsed = (double)(SDL_GetPerformanceCounter() - frame_start) / ticks_per_sec;
+            double remaining = 1.0 / refresh_hz - elapsed;
+            if (remaining > 0.001) {
+                SDL_Delay((Uint32)(remaining * 1000.0));
+            }
+        }
     }
     
+    stats_save(&opponent_stats, STATS_FILE);
     cleanup();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,608 @@
+/*
+ * Table Stream - seqlock event ring, bot command ring and futex wakeups
+ *
+ * Record n lives in slot n % STREAM_SLOTS. The writer zeroes the slot's
+ * sequence word, fills in the payload, then stores n + 1 into it; a
+ * reader copies the payload between two loads of the sequence word and
+ * keeps the copy only if both read n + 1. Payload words are moved with
+ * relaxed atomics so the racing copy is well defined. A bot's private
+ * hand object is a single slot written the same way, stamped with the
+ * record it goes with.
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+#include "table_stream.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef __linux__
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#define STREAM_MAGIC 0x52545350u   /* "PSTR" */
+#define STREAM_VERSION 2
+#define STREAM_WORDS (sizeof(StreamRecord) / sizeof(uint32_t))
+
+typedef struct {
+    uint32_t seq;                     /* Record index + 1 once written, 0 while being written */
+    uint32_t words[STREAM_WORDS];
+} StreamSlot;
+
+typedef struct {
+    uint32_t seq;                     /* Free for the producer at position seq, ready at position + 1 */
+    StreamCommand cmd;
+} StreamCommandSlot;
+
+/* A bot's own cards - never in the shared ring */
+struct StreamHand {
+    uint32_t seq;                     /* Record index + 1 these cards go with, 0 while being written */
+    uint32_t words[2];                /* The packed hand */
+};
+
+struct StreamShared {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t closed;                  /* The game has gone - readers get -1 once drained */
+    uint32_t bot_seats;               /* Seats the front end lets bots claim, bit per seat */
+    int32_t bot_pid[NUM_SEATS];       /* Process that claimed each seat, 0 for none */
+    
+    /* Written on every publish - kept off the line the readers' waiter count lives on */
+    uint32_t head __attribute__((aligned(64)));   /* Records published */
+    uint32_t wake;                    /* Futex word, bumped on every publish */
+    uint32_t waiters __attribute__((aligned(64)));
+    
+    uint32_t cmd_head __attribute__((aligned(64)));   /* Next position a bot claims */
+    uint32_t cmd_tail;                /* Next position the game reads - game only */
+    StreamCommandSlot commands[STREAM_COMMANDS];
+    
+    StreamSlot slots[STREAM_SLOTS] __attribute__((aligned(64)));
+};
+
+static StreamShared* stream = NULL;
+static char stream_name[64];
+static uint32_t turn_record = 0;         /* Last state change published - older commands are stale */
+static int32_t seen_bot[NUM_SEATS];
+static StreamHand* bot_hand[NUM_SEATS];   /* Mapped private hand of each seat's bot */
+static int32_t bot_hand_pid[NUM_SEATS];
+
+static long futex(uint32_t* addr, int op, uint32_t val, const struct timespec* timeout) {
+    return syscall(SYS_futex, addr, op, val, timeout, NULL, 0);
+}
+
+/* Cards travel as one byte each; 0 means the hand isn't shown */
+static uint8_t pack_card(Card c) {
+    return (uint8_t)(c.rank << 2 | c.suit);
+}
+
+/* Name of the private hand object for the bot with this pid */
+static void hand_object_name(char* out, size_t size, const char* stream, int32_t pid) {
+    snprintf(out, size, "%s.bot%d", stream, (int)pid);
+}
+
+/* Map a bot's private hand object - NULL if it isn't there or is the wrong size */
+static StreamHand* map_hand(const char* name, int flags) {
+    int fd = shm_open(name, flags, 0600);
+    if (fd < 0) return NULL;
+    if ((flags & O_CREAT) && ftruncate(fd, sizeof(StreamHand)) != 0) {
+        close(fd);
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size != (off_t)sizeof(StreamHand)) {
+        close(fd);
+        return NULL;
+    }
+    void* mem = mmap(NULL, sizeof(StreamHand), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    return mem == MAP_FAILED ? NULL : mem;
+}
+
+/* Follow the seat's claim: map the claiming bot's hand object, or let go of the last one */
+static StreamHand* seat_hand(Seat seat) {
+    int32_t pid = __atomic_load_n(&stream->bot_pid[seat], __ATOMIC_ACQUIRE);
+    if (pid == bot_hand_pid[seat]) return bot_hand[seat];
+    
+    /* The last bot may have died without detaching - its object goes too */
+    char name[80];
+    if (bot_hand[seat]) munmap(bot_hand[seat], sizeof(StreamHand));
+    if (bot_hand_pid[seat]) {
+        hand_object_name(name, sizeof(name), stream_name, bot_hand_pid[seat]);
+        shm_unlink(name);
+    }
+    bot_hand[seat] = NULL;
+    bot_hand_pid[seat] = pid;
+    if (pid) {
+        hand_object_name(name, sizeof(name), stream_name, pid);
+        bot_hand[seat] = map_hand(name, O_RDWR);
+    }
+    return bot_hand[seat];
+}
+
+/* A claim is only good while the claiming process is alive - drop it otherwise */
+static int32_t live_bot(StreamShared* shm, Seat seat) {
+    int32_t pid = __atomic_load_n(&shm->bot_pid[seat], __ATOMIC_ACQUIRE);
+    if (pid == 0) return 0;
+    if (kill(pid, 0) == 0 || errno != ESRCH) return pid;
+    __atomic_compare_exchange_n(&shm->bot_pid[seat], &pid, 0, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+    return 0;
+}
+
+/*
+ * Create the stream under name (e.g. "/sdl_poker_table"), replacing a stale
+ * one. Bots may claim only the seats in bot_seats (bit per seat). 0 on success
+ */
+int table_stream_open(const char* name, unsigned int bot_seats) {
+    if (stream) return 0;
+    
+    shm_unlink(name);
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        printf("Failed to create table stream %s: %s\n", name, strerror(errno));
+        return -1;
+    }
+    if (ftruncate(fd, sizeof(StreamShared)) != 0) {
+        printf("Failed to size table stream %s: %s\n", name, strerror(errno));
+        close(fd);
+        shm_unlink(name);
+        return -1;
+    }
+    void* mem = mmap(NULL, sizeof(StreamShared), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED) {
+        printf("Failed to map table stream %s: %s\n", name, strerror(errno));
+        shm_unlink(name);
+        return -1;
+    }
+    
+    /* ftruncate zero-filled everything else */
+    stream = mem;
+    for (uint32_t i = 0; i < STREAM_COMMANDS; i++) {
+        stream->commands[i].seq = i;
+    }
+    stream->version = STREAM_VERSION;
+    stream->bot_seats = bot_seats & ((1u << NUM_SEATS) - 1);
+    __atomic_store_n(&stream->magic, STREAM_MAGIC, __ATOMIC_RELEASE);
+    
+    snprintf(stream_name, sizeof(stream_name), "%s", name);
+    turn_record = 0;
+    memset(seen_bot, 0, sizeof(seen_bot));
+    memset(bot_hand, 0, sizeof(bot_hand));
+    memset(bot_hand_pid, 0, sizeof(bot_hand_pid));
+    printf("Streaming the table to %s\n", name);
+    return 0;
+}
+
+/*
+ * Write one event and a snapshot of the table into the ring. Never blocks:
+ * the only syscall is a futex wake, made only when a reader is asleep.
+ * Hands go in the ring only once shown down; a bot's own cards go to its
+ * private hand object, stamped with this record's index.
+ */
+void table_stream_publish(const PokerGame* g, const PokerEvent* ev) {
+    if (!stream) return;
+    
+    StreamRecord rec;
+    memset(&rec, 0, sizeof(rec));
+    uint32_t n = stream->head;
+    rec.index = n;
+    rec.type = ev->type;
+    rec.seat = ev->seat;
+    rec.action = ev->action;
+    rec.amount = ev->amount;
+    rec.facing_bet = ev->facing_bet;
+    rec.street = ev->street;
+    rec.cards = ev->cards;
+    rec.hand_rank = ev->hand_rank;
+    rec.prev_state = ev->prev_state;
+    rec.state = ev->state;
+    rec.pot = g->pot;
+    rec.to_call = g->to_call;
+    rec.ante = g->rules.ante;
+    rec.bet_size = g->rules.bet_size;
+    rec.draw_rounds = g->rules.draw_rounds;
+    rec.variant = (uint8_t)g->rules.variant;
+    rec.winner = g->winner;
+    for (int seat = 0; seat < NUM_SEATS; seat++) {
+        rec.chips[seat] = g->chips[seat];
+        rec.drawn[seat] = g->drawn[seat];
+        uint8_t packed[2 * sizeof(uint32_t)] = {0};
+        for (int i = 0; i < HAND_SIZE; i++) {
+            packed[i] = pack_card(g->hands[seat][i]);
+        }
+        if (g->revealed) memcpy(rec.hands[seat], packed, HAND_SIZE);
+        
+        StreamHand* hand = seat_hand((Seat)seat);
+        if (!hand) continue;
+        uint32_t words[2];
+        memcpy(words, packed, sizeof(words));
+        __atomic_store_n(&hand->seq, 0, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        __atomic_store_n(&hand->words[0], words[0], __ATOMIC_RELAXED);
+        __atomic_store_n(&hand->words[1], words[1], __ATOMIC_RELAXED);
+        __atomic_store_n(&hand->seq, n + 1, __ATOMIC_RELEASE);
+    }
+    
+    StreamSlot* slot = &stream->slots[n & (STREAM_SLOTS - 1)];
+    const uint32_t* words = (const uint32_t*)&rec;
+    __atomic_store_n(&slot->seq, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    for (size_t i = 0; i < STREAM_WORDS; i++) {
+        __atomic_store_n(&slot->words[i], words[i], __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&slot->seq, n + 1, __ATOMIC_RELEASE);
+    
+    /* Pairs with the waiter count and wake word in table_stream_read */
+    __atomic_store_n(&stream->head, n + 1, __ATOMIC_SEQ_CST);
+    __atomic_add_fetch(&stream->wake, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&stream->waiters, __ATOMIC_SEQ_CST) > 0) {
+        futex(&stream->wake, FUTEX_WAKE, INT32_MAX, NULL);
+    }
+    
+    if (ev->type == EVENT_STATE) turn_record = n;
+}
+
+/*
+ * Whether a live bot is playing seat. When a bot has just taken the seat,
+ * a fresh snapshot goes out so it sees its cards without waiting for the
+ * next event.
+ */
+int table_stream_bot(const PokerGame* g, Seat seat) {
+    if (!stream || !(stream->bot_seats & (1u << seat))) return 0;
+    
+    int32_t pid = live_bot(stream, seat);
+    if (pid != seen_bot[seat]) {
+        if (pid) {
+            printf("Bot %d took seat %d\n", (int)pid, (int)seat);
+        } else {
+            printf("Bot left seat %d\n", (int)seat);
+        }
+        seen_bot[seat] = pid;
+        if (pid) {
+            PokerEvent ev = {.type = EVENT_STATE, .seat = poker_acting_seat(g)};
+            ev.street = g->street;
+            ev.prev_state = g->state;
+            ev.state = g->state;
+            table_stream_publish(g, &ev);
+        }
+    }
+    return pid != 0;
+}
+
+/*
+ * Take the next command for seat, dropping any meant for another seat or
+ * answering a turn that has already passed. Returns 1 with *out filled in,
+ * 0 if nothing is waiting.
+ */
+int table_stream_poll(Seat seat, StreamCommand* out) {
+    if (!stream) return 0;
+    
+    for (;;) {
+        uint32_t pos = stream->cmd_tail;
+        StreamCommandSlot* slot = &stream->commands[pos & (STREAM_COMMANDS - 1)];
+        if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != pos + 1) return 0;
+        
+        StreamCommand cmd = slot->cmd;
+        __atomic_store_n(&slot->seq, pos + STREAM_COMMANDS, __ATOMIC_RELEASE);
+        stream->cmd_tail = pos + 1;
+        
+        if (cmd.seat == (int32_t)seat && (int32_t)(cmd.record - turn_record) >= 0) {
+            *out = cmd;
+            return 1;
+        }
+    }
+}
+
+/* Tell readers the game is over and remove the name; attached readers keep their mapping */
+void table_stream_close() {
+    if (!stream) return;
+    
+    __atomic_store_n(&stream->closed, 1, __ATOMIC_SEQ_CST);
+    __atomic_add_fetch(&stream->wake, 1, __ATOMIC_SEQ_CST);
+    futex(&stream->wake, FUTEX_WAKE, INT32_MAX, NULL);
+    for (int seat = 0; seat < NUM_SEATS; seat++) {
+        if (bot_hand[seat]) munmap(bot_hand[seat], sizeof(StreamHand));
+        bot_hand[seat] = NULL;
+    }
+    munmap(stream, sizeof(StreamShared));
+    shm_unlink(stream_name);
+    stream = NULL;
+}
+
+/* Map an existing stream, starting from its latest record - 0 on success */
+int table_stream_attach(StreamReader* r, const char* name) {
+    memset(r, 0, sizeof(*r));
+    r->seat = -1;
+    
+    int fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0) {
+        printf("No table stream at %s: %s\n", name, strerror(errno));
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size != (off_t)sizeof(StreamShared)) {
+        printf("Table stream %s has the wrong size - built from another version?\n", name);
+        close(fd);
+        return -1;
+    }
+    void* mem = mmap(NULL, sizeof(StreamShared), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED) {
+        printf("Failed to map table stream %s: %s\n", name, strerror(errno));
+        return -1;
+    }
+    
+    StreamShared* shm = mem;
+    if (__atomic_load_n(&shm->magic, __ATOMIC_ACQUIRE) != STREAM_MAGIC || shm->version != STREAM_VERSION) {
+        printf("Table stream %s is not ready or not a version %d stream\n", name, STREAM_VERSION);
+        munmap(mem, sizeof(StreamShared));
+        return -1;
+    }
+    
+    r->shm = shm;
+    snprintf(r->name, sizeof(r->name), "%s", name);
+    uint32_t head = __atomic_load_n(&shm->head, __ATOMIC_ACQUIRE);
+    r->next = head ? head - 1 : 0;
+    return 0;
+}
+
+/* Fill in the bot's own cards if its hand object holds the ones for this record */
+static void read_hand(const StreamReader* r, StreamRecord* rec) {
+    uint32_t words[2];
+    uint32_t before = __atomic_load_n(&r->hand->seq, __ATOMIC_ACQUIRE);
+    words[0] = __atomic_load_n(&r->hand->words[0], __ATOMIC_RELAXED);
+    words[1] = __atomic_load_n(&r->hand->words[1], __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    uint32_t after = __atomic_load_n(&r->hand->seq, __ATOMIC_RELAXED);
+    if (before != rec->index + 1 || after != before) return;
+    memcpy(rec->hands[r->seat], words, HAND_SIZE);
+}
+
+/*
+ * Copy out the next record. Waits up to timeout_ms (-1 for ever) when
+ * caught up. Returns 1 for a record, 0 on timeout, -1 once the game has
+ * closed the stream. A reader lapped by the writer jumps forward half a
+ * ring and counts what it missed in r->lost.
+ */
+int table_stream_read(StreamReader* r, StreamRecord* out, int timeout_ms) {
+    StreamShared* shm = r->shm;
+    if (!shm) return -1;
+    
+    /* One deadline for the whole call, however many times the futex wakes early */
+    struct timespec deadline;
+    if (timeout_ms > 0) {
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += timeout_ms / 1000;
+        deadline.tv_nsec += (timeout_ms % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+    }
+    
+    for (;;) {
+        uint32_t head = __atomic_load_n(&shm->head, __ATOMIC_ACQUIRE);
+        if (head != r->next) {
+            StreamSlot* slot = &shm->slots[r->next & (STREAM_SLOTS - 1)];
+            uint32_t* words = (uint32_t*)out;
+            uint32_t before = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+            for (size_t i = 0; i < STREAM_WORDS; i++) {
+                words[i] = __atomic_load_n(&slot->words[i], __ATOMIC_RELAXED);
+            }
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            uint32_t after = __atomic_load_n(&slot->seq, __ATOMIC_RELAXED);
+            
+            if (before == r->next + 1 && after == before) {
+                r->next++;
+                if (r->hand) read_hand(r, out);
+                return 1;
+            }
+            
+            /* Overwritten under us - skip to where the writer won't catch us straight away */
+            uint32_t skip_to = head - STREAM_SLOTS / 2;
+            if ((int32_t)(skip_to - r->next) <= 0) skip_to = head - 1;
+            r->lost += skip_to - r->next;
+            r->next = skip_to;
+            continue;
+        }
+        
+        if (__atomic_load_n(&shm->closed, __ATOMIC_SEQ_CST)) return -1;
+        if (timeout_ms == 0) return 0;
+        
+        /* FUTEX_WAIT takes a relative timeout - give it what's left */
+        struct timespec left;
+        if (timeout_ms > 0) {
+            struct timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            left.tv_sec = deadline.tv_sec - now.tv_sec;
+            left.tv_nsec = deadline.tv_nsec - now.tv_nsec;
+            if (left.tv_nsec < 0) {
+                left.tv_sec--;
+                left.tv_nsec += 1000000000L;
+            }
+            if (left.tv_sec < 0) return 0;
+        }
+        
+        __atomic_add_fetch(&shm->waiters, 1, __ATOMIC_SEQ_CST);
+        uint32_t wake = __atomic_load_n(&shm->wake, __ATOMIC_SEQ_CST);
+        long slept = 0;
+        if (__atomic_load_n(&shm->head, __ATOMIC_SEQ_CST) == r->next &&
+            !__atomic_load_n(&shm->closed, __ATOMIC_SEQ_CST)) {
+            slept = futex(&shm->wake, FUTEX_WAIT, wake, timeout_ms < 0 ? NULL : &left);
+        }
+        __atomic_sub_fetch(&shm->waiters, 1, __ATOMIC_SEQ_CST);
+        
+        if (slept != 0 && errno == ETIMEDOUT) return 0;
+    }
+}
+
+/*
+ * Take seat as a bot - fails for a seat the front end hasn't handed to
+ * bots, or while another live process holds it. The private hand object
+ * is created before the claim is made, so the game finds it at once.
+ * 0 on success
+ */
+int table_stream_claim(StreamReader* r, Seat seat) {
+    if (!r->shm || r->seat >= 0) return -1;
+    if ((int)seat < 0 || seat >= NUM_SEATS || !(r->shm->bot_seats & (1u << seat))) {
+        printf("Seat %d is not open to bots\n", (int)seat);
+        return -1;
+    }
+    
+    int32_t me = (int32_t)getpid();
+    int32_t holder = live_bot(r->shm, seat);
+    if (holder != 0) {
+        printf("Seat %d is already played by bot %d\n", (int)seat, (int)holder);
+        return -1;
+    }
+    
+    hand_object_name(r->hand_name, sizeof(r->hand_name), r->name, me);
+    shm_unlink(r->hand_name);
+    r->hand = map_hand(r->hand_name, O_CREAT | O_EXCL | O_RDWR);
+    if (!r->hand) {
+        printf("Failed to create %s: %s\n", r->hand_name, strerror(errno));
+        return -1;
+    }
+    
+    if (!__atomic_compare_exchange_n(&r->shm->bot_pid[seat], &holder, me, 0,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+        printf("Seat %d was just taken by bot %d\n", (int)seat, (int)holder);
+        munmap(r->hand, sizeof(StreamHand));
+        shm_unlink(r->hand_name);
+        r->hand = NULL;
+        return -1;
+    }
+    r->seat = seat;
+    return 0;
+}
+
+/* Queue a command for the game - 0 on success, -1 if the ring is full */
+int table_stream_send(StreamReader* r, const StreamCommand* cmd) {
+    if (!r->shm) return -1;
+    
+    StreamShared* shm = r->shm;
+    uint32_t pos = __atomic_load_n(&shm->cmd_head, __ATOMIC_RELAXED);
+    for (;;) {
+        StreamCommandSlot* slot = &shm->commands[pos & (STREAM_COMMANDS - 1)];
+        int32_t diff = (int32_t)(__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) - pos);
+        if (diff < 0) return -1;
+        if (diff > 0) {
+            pos = __atomic_load_n(&shm->cmd_head, __ATOMIC_RELAXED);
+            continue;
+        }
+        if (__atomic_compare_exchange_n(&shm->cmd_head, &pos, pos + 1, 1,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            slot->cmd = *cmd;
+            __atomic_store_n(&slot->seq, pos + 1, __ATOMIC_RELEASE);
+            return 0;
+        }
+    }
+}
+
+/* Give up any seat claimed and unmap */
+void table_stream_detach(StreamReader* r) {
+    if (!r->shm) return;
+    
+    if (r->seat >= 0) {
+        int32_t me = (int32_t)getpid();
+        __atomic_compare_exchange_n(&r->shm->bot_pid[r->seat], &me, 0, 0,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+        munmap(r->hand, sizeof(StreamHand));
+        shm_unlink(r->hand_name);
+        r->hand = NULL;
+        r->seat = -1;
+    }
+    munmap(r->shm, sizeof(StreamShared));
+    r->shm = NULL;
+}
+
+#else
+
+int table_stream_open(const char* name, unsigned int bot_seats) {
+    (void)bot_seats;
+    printf("Table streaming is only supported on Linux, not opening %s\n", name);
+    return -1;
+}
+
+void table_stream_publish(const PokerGame* g, const PokerEvent* ev) {
+    (void)g;
+    (void)ev;
+}
+
+int table_stream_bot(const PokerGame* g, Seat seat) {
+    (void)g;
+    (void)seat;
+    return 0;
+}
+
+int table_stream_poll(Seat seat, StreamCommand* out) {
+    (void)seat;
+    (void)out;
+    return 0;
+}
+
+void table_stream_close() {
+}
+
+int table_stream_attach(StreamReader* r, const char* name) {
+    memset(r, 0, sizeof(*r));
+    r->seat = -1;
+    printf("Table streaming is only supported on Linux, not attaching to %s\n", name);
+    return -1;
+}
+
+int table_stream_read(StreamReader* r, StreamRecord* out, int timeout_ms) {
+    (void)r;
+    (void)out;
+    (void)timeout_ms;
+    return -1;
+}
+
+int table_stream_claim(StreamReader* r, Seat seat) {
+    (void)r;
+    (void)seat;
+    return -1;
+}
+
+int table_stream_send(StreamReader* r, const StreamCommand* cmd) {
+    (void)r;
+    (void)cmd;
+    return -1;
+}
+
+void table_stream_detach(StreamReader* r) {
+    (void)r;
+}
+
+#endif
+
+/* Rebuild enough of a PokerGame from a record for the core AI to decide on (RNG and observer untouched) */
+void table_stream_to_game(const StreamRecord* rec, PokerGame* g) {
+    g->rules.ante = rec->ante;
+    g->rules.bet_size = rec->bet_size;
+    g->rules.draw_rounds = rec->draw_rounds;
+    g->rules.variant = (Variant)rec->variant;
+    g->pot = rec->pot;
+    g->to_call = rec->to_call;
+    g->street = rec->street;
+    g->state = (GameState)rec->state;
+    g->winner = rec->winner;
+    for (int seat = 0; seat < NUM_SEATS; seat++) {
+        g->chips[seat] = rec->chips[seat];
+        g->drawn[seat] = rec->drawn[seat];
+        for (int i = 0; i < HAND_SIZE; i++) {
+            g->hands[seat][i].rank = (Rank)(rec->hands[seat][i] >> 2);
+            g->hands[seat][i].suit = (Suit)(rec->hands[seat][i] & 3);
+        }
+    }
+}
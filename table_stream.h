@@ -0,0 +1,102 @@
+/*
+ * Table Stream - the live table in shared memory, for spectators and bots
+ * Linux only (POSIX shm and a futex); elsewhere table_stream_open() and
+ * table_stream_attach() report failure and publishing does nothing.
+ *
+ * The game writes every state machine event, with a snapshot of the
+ * table, into a ring of slots in a shared memory object. Each slot is a
+ * seqlock, so the writer never waits on anyone: a reader that falls a lap
+ * behind sees its slots were overwritten and skips ahead. Readers attach
+ * and detach whenever they like without the game noticing, and sleep on
+ * a futex that the game only wakes when somebody is actually waiting.
+ *
+ * Commands go the other way through a small ring that any number of bot
+ * processes push into and the game drains between frames. A bot claims a
+ * seat first - only a seat the front end opened the stream with - and
+ * while it lives, the front end takes that seat's decisions from the ring
+ * instead of running its own AI.
+ *
+ * The ring only ever carries hands once they are shown down. A bot gets
+ * its own seat's cards through a small shm object of its own, named after
+ * the stream and its pid, which spectators never map.
+ */
+
+#ifndef TABLE_STREAM_H
+#define TABLE_STREAM_H
+
+#include "poker_core.h"
+
+#define STREAM_DEFAULT_NAME "/sdl_poker_table"
+#define STREAM_SLOTS 1024          /* Power of two */
+#define STREAM_COMMANDS 64         /* Power of two */
+
+/* One event and the table as it stood once the event happened - all fixed-width */
+typedef struct {
+    uint32_t index;                      /* Records published before this one */
+    int32_t type;                        /* PokerEventType */
+    int32_t seat;
+    int32_t action;
+    int32_t amount;
+    int32_t facing_bet;
+    int32_t street;
+    int32_t cards;
+    int32_t hand_rank;
+    int32_t prev_state;
+    int32_t state;
+    int32_t pot;
+    int32_t to_call;
+    int32_t ante;
+    int32_t bet_size;
+    int32_t draw_rounds;
+    int32_t winner;
+    int32_t chips[NUM_SEATS];
+    int32_t drawn[NUM_SEATS];
+    uint8_t hands[NUM_SEATS][HAND_SIZE]; /* rank << 2 | suit; 0 while a hand is hidden (a bot's own seat filled in by read) */
+    uint8_t variant;                     /* Variant being played */
+    uint8_t pad;
+} StreamRecord;
+
+typedef enum {
+    STREAM_CMD_ACT,
+    STREAM_CMD_DRAW
+} StreamCommandKind;
+
+/* A bot's decision for the seat it has claimed */
+typedef struct {
+    uint32_t record;          /* Index of the record the bot was answering */
+    int32_t kind;             /* StreamCommandKind */
+    int32_t seat;
+    int32_t action;           /* STREAM_CMD_ACT */
+    uint32_t discard_mask;    /* STREAM_CMD_DRAW */
+} StreamCommand;
+
+typedef struct StreamShared StreamShared;
+typedef struct StreamHand StreamHand;
+
+/* A spectator's or bot's view of the stream */
+typedef struct {
+    StreamShared* shm;
+    uint32_t next;            /* Index of the next record to read */
+    uint32_t lost;            /* Records overwritten before we got to them */
+    char name[64];
+    int seat;                 /* Seat claimed as a bot, -1 for none */
+    StreamHand* hand;         /* The claimed seat's private cards */
+    char hand_name[80];
+} StreamReader;
+
+/* Game side */
+int table_stream_open(const char* name, unsigned int bot_seats);
+void table_stream_publish(const PokerGame* g, const PokerEvent* ev);
+int table_stream_bot(const PokerGame* g, Seat seat);
+int table_stream_poll(Seat seat, StreamCommand* out);
+void table_stream_close();
+
+/* Reader side */
+int table_stream_attach(StreamReader* r, const char* name);
+int table_stream_read(StreamReader* r, StreamRecord* out, int timeout_ms);
+int table_stream_claim(StreamReader* r, Seat seat);
+int table_stream_send(StreamReader* r, const StreamCommand* cmd);
+void table_stream_detach(StreamReader* r);
+void table_stream_to_game(const StreamRecord* rec, PokerGame* g);
+
+#endif
@@ -0,0 +1,138 @@
+/*
+ * Table Watch - follows a running game through its table stream
+ * Start the game with POKER_STREAM=1 (or POKER_STREAM=/name), then:
+ *
+ *   ./table_watch [--name /shm_name] [--bot]
+ *
+ * prints every event as it happens. With --bot it also takes the AI seat
+ * and plays it with the core AI from the other end of the command ring.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "poker_core.h"
+#include "poker_ai.h"
+#include "poker_variant.h"
+#include "table_stream.h"
+
+#define WATCH_TIMEOUT_MS 1000
+
+static const char* state_names[] = {
+    "START_ROUND", "PLAYER_TURN", "AI_TURN", "PLAYER_DRAW", "AI_DRAW", "SHOWDOWN", "ROUND_END", "GAME_OVER"
+};
+static const char* action_names[] = {"checks", "bets", "calls", "folds"};
+static const char* seat_names[] = {"Player", "AI"};
+
+/* Write a shown hand as "AS KH ..." - hidden hands print as "--" */
+static void print_hand(const uint8_t* cards) {
+    for (int i = 0; i < HAND_SIZE; i++) {
+        if (cards[i] == 0) {
+            printf(" --");
+            continue;
+        }
+        printf(" %s%c", rank_to_string((Rank)(cards[i] >> 2)), "HDCS"[cards[i] & 3]);
+    }
+}
+
+/* One line per record */
+static void print_record(const StreamRecord* rec) {
+    printf("#%-6u ", rec->index);
+    switch (rec->type) {
+        case EVENT_ROUND_START:
+            printf("New round of %s - ante %d, pot %d, stacks %d / %d", variant_info((Variant)rec->variant)->name,
+                   rec->ante, rec->pot, rec->chips[SEAT_PLAYER], rec->chips[SEAT_AI]);
+            break;
+        case EVENT_ACTION:
+            printf("%s %s", seat_names[rec->seat], action_names[rec->action]);
+            if (rec->amount) printf(" %d", rec->amount);
+            printf(" (pot %d)", rec->pot);
+            break;
+        case EVENT_DRAW:
+            printf("%s draws %d", seat_names[rec->seat], rec->cards);
+            break;
+        case EVENT_SHOWDOWN:
+            printf("%s shows %s:", seat_names[rec->seat], hand_rank_to_string((HandRank)rec->hand_rank));
+            print_hand(rec->hands[rec->seat]);
+            break;
+        case EVENT_ROUND_END:
+            if (rec->seat < 0) {
+                printf("Split pot");
+            } else {
+                printf("%s wins", seat_names[rec->seat]);
+            }
+            printf(" - stacks %d / %d", rec->chips[SEAT_PLAYER], rec->chips[SEAT_AI]);
+            break;
+        case EVENT_STATE:
+            printf("  %s -> %s", state_names[rec->prev_state], state_names[rec->state]);
+            break;
+    }
+    printf("\n");
+}
+
+/* Answer a record that puts our seat on the move */
+static void play_turn(StreamReader* r, const StreamRecord* rec, PokerGame* view) {
+    int acting = (rec->state == AI_TURN || rec->state == AI_DRAW) ? SEAT_AI : SEAT_PLAYER;
+    int betting = rec->state == PLAYER_TURN || rec->state == AI_TURN;
+    int drawing = rec->state == PLAYER_DRAW || rec->state == AI_DRAW;
+    if (rec->type != EVENT_STATE || acting != r->seat || (!betting && !drawing)) return;
+    if (rec->hands[r->seat][0] == 0) return;  /* Our cards didn't come through with this record */
+    
+    table_stream_to_game(rec, view);
+    StreamCommand cmd = {.record = rec->index, .seat = r->seat};
+    if (betting) {
+        cmd.kind = STREAM_CMD_ACT;
+        cmd.action = ai_choose_action(view, (Seat)r->seat, NULL);
+    } else {
+        cmd.kind = STREAM_CMD_DRAW;
+        cmd.discard_mask = ai_choose_discards(view, (Seat)r->seat, NULL);
+    }
+    if (table_stream_send(r, &cmd) != 0) {
+        printf("Command ring full - the game isn't reading\n");
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const char* name = STREAM_DEFAULT_NAME;
+    int bot = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--name") == 0 && i + 1 < argc) {
+            name = argv[++i];
+        } else if (strcmp(argv[i], "--bot") == 0) {
+            bot = 1;
+        }
+    }
+    
+    StreamReader reader;
+    if (table_stream_attach(&reader, name) != 0) return 1;
+    if (bot && table_stream_claim(&reader, SEAT_AI) != 0) {
+        table_stream_detach(&reader);
+        return 1;
+    }
+    printf("Watching %s%s\n", name, bot ? " and playing the AI seat" : "");
+    
+    PokerGame view;
+    PokerRules rules = {0};
+    poker_game_init(&view, &rules, 1);
+    
+    uint32_t lost = 0;
+    for (;;) {
+        StreamRecord rec;
+        int got = table_stream_read(&reader, &rec, WATCH_TIMEOUT_MS);
+        if (got < 0) {
+            printf("The game closed the stream\n");
+            break;
+        }
+        if (got == 0) continue;
+        
+        if (reader.lost != lost) {
+            printf("... fell behind, skipped %u records\n", reader.lost - lost);
+            lost = reader.lost;
+        }
+        print_record(&rec);
+        if (bot) play_turn(&reader, &rec, &view);
+    }
+    
+    table_stream_detach(&reader);
+    return 0;
+}
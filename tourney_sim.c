@@ -0,0 +1,195 @@
+/*
+ * Tournament Simulator - headless, multi-threaded
+ * Plays many AI-only tournaments with the poker core and reports
+ * throughput, the prize share each seat took, and the cost of one ICM
+ * evaluation at the chosen field size.
+ *
+ *   ./tourney_sim [tournaments] [players] [threads] [variant]
+ *
+ * where variant is a key from poker_variant_spec.h (draw, 27, a5, deuces, joker).
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include <pthread.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "poker_core.h"
+#include "poker_tourney.h"
+#include "poker_variant.h"
+#include "trace.h"
+
+#define DEFAULT_TOURNAMENTS 1000
+#define DEFAULT_PLAYERS 10
+#define DEFAULT_THREADS 4
+#define MAX_TOURNAMENTS 10000000   /* Keeps tournaments * threads in an int when splitting the work */
+#define MAX_THREADS 64
+#define STARTING_CHIPS 1000
+#define ICM_BENCH_CALLS 2000
+
+/* One worker's share of the run and what it found */
+typedef struct {
+    pthread_t thread;
+    int first;
+    int count;
+    int players;
+    Variant variant;
+    long hands;
+    double prize[TOURNEY_MAX_PLAYERS];
+} SimWorker;
+
+/* Wall clock in seconds */
+static double now_seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Play this worker's tournaments back to back - each seeded by its index, so runs repeat */
+static void* run_worker(void* arg) {
+    SimWorker* w = arg;
+    TRACE_THREAD_NAME("sim worker");
+    TourneyConfig cfg;
+    tourney_default_config(&cfg, w->players, STARTING_CHIPS);
+    cfg.variant = w->variant;
+    cfg.draw_rounds = variant_info(w->variant)->draw_rounds;
+    
+    for (int i = 0; i < w->count; i++) {
+        Tournament t;
+        if (!tourney_init(&t, &cfg, (uint64_t)(w->first + i) + 1)) {
+            printf("Out of memory for the ICM workspace\n");
+            break;
+        }
+        tourney_run(&t);
+        w->hands += t.hands;
+        for (int p = 0; p < cfg.players; p++) {
+            w->prize[p] += tourney_prize(&t, p);
+        }
+        tourney_free(&t);
+    }
+    return NULL;
+}
+
+/* Time icm_equity on random stacks, defeating the memo with a fresh vector each call */
+static void bench_icm(int players) {
+    TourneyConfig cfg;
+    tourney_default_config(&cfg, players, STARTING_CHIPS);
+    IcmWorkspace* icm = icm_new(cfg.payouts, cfg.paid);
+    if (!icm) return;
+    
+    PokerRng rng;
+    rng_seed(&rng, 1);
+    int stacks[ICM_MAX_PLAYERS];
+    double equity[ICM_MAX_PLAYERS];
+    double start = now_seconds();
+    for (int call = 0; call < ICM_BENCH_CALLS; call++) {
+        for (int i = 0; i < cfg.players; i++) {
+            stacks[i] = 1 + rng_range(&rng, 2 * STARTING_CHIPS);
+        }
+        icm_equity(icm, stacks, cfg.players, equity);
+    }
+    double us = (now_seconds() - start) * 1e6 / ICM_BENCH_CALLS;
+    printf("ICM: %d stacks, %d paid: %.2f us per evaluation\n", cfg.players, cfg.paid, us);
+    icm_free(icm);
+}
+
+static void usage(const char* program) {
+    printf("Usage: %s [tournaments] [players] [threads] [variant]\n", program);
+    printf("  tournaments  1 - %d (default %d)\n", MAX_TOURNAMENTS, DEFAULT_TOURNAMENTS);
+    printf("  players      2 - %d (default %d)\n", TOURNEY_MAX_PLAYERS, DEFAULT_PLAYERS);
+    printf("  threads      1 - %d (default %d)\n", MAX_THREADS, DEFAULT_THREADS);
+    printf("  variant      ");
+    for (int v = 0; v < NUM_VARIANTS; v++) {
+        printf("%s%s", v ? ", " : "", variant_info((Variant)v)->key);
+    }
+    printf(" (default %s)\n", variant_info(VARIANT_DRAW_HIGH)->key);
+}
+
+/* Whole decimal number in [lo, hi], or 0 if arg is anything else */
+static int parse_count(const char* arg, const char* what, int lo, int hi, int* out) {
+    char* end;
+    errno = 0;
+    long value = strtol(arg, &end, 10);
+    if (end == arg || *end != '\0' || errno == ERANGE || value < lo || value > hi) {
+        printf("%s must be a number from %d to %d, not \"%s\"\n", what, lo, hi, arg);
+        return 0;
+    }
+    *out = (int)value;
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    TRACE_THREAD_NAME("main");
+    if (argc > 1 && (strcmp(argv[1], "--help") == 0 || strcmp(argv[1], "-h") == 0)) {
+        usage(argv[0]);
+        return 0;
+    }
+    int tournaments = DEFAULT_TOURNAMENTS;
+    int players = DEFAULT_PLAYERS;
+    int threads = DEFAULT_THREADS;
+    int variant = VARIANT_DRAW_HIGH;
+    if (argc > 5 ||
+        (argc > 1 && !parse_count(argv[1], "tournaments", 1, MAX_TOURNAMENTS, &tournaments)) ||
+        (argc > 2 && !parse_count(argv[2], "players", 2, TOURNEY_MAX_PLAYERS, &players)) ||
+        (argc > 3 && !parse_count(argv[3], "threads", 1, MAX_THREADS, &threads))) {
+        usage(argv[0]);
+        return 1;
+    }
+    if (argc > 4) {
+        variant = variant_from_key(argv[4]);
+        if (variant < 0) {
+            printf("Unknown variant %s\n", argv[4]);
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (threads > tournaments) threads = tournaments;
+    
+    bench_icm(players);
+    
+    SimWorker workers[MAX_THREADS] = {0};
+    double start = now_seconds();
+    for (int i = 0; i < threads; i++) {
+        workers[i].first = tournaments * i / threads;
+        workers[i].count = tournaments * (i + 1) / threads - workers[i].first;
+        workers[i].players = players;
+        workers[i].variant = (Variant)variant;
+        if (pthread_create(&workers[i].thread, NULL, run_worker, &workers[i]) != 0) {
+            printf("Failed to start worker thread %d\n", i);
+            return 1;
+        }
+    }
+    
+    long hands = 0;
+    double prize[TOURNEY_MAX_PLAYERS] = {0};
+    for (int i = 0; i < threads; i++) {
+        pthread_join(workers[i].thread, NULL);
+        hands += workers[i].hands;
+        for (int p = 0; p < players; p++) {
+            prize[p] += workers[i].prize[p];
+        }
+    }
+    double elapsed = now_seconds() - start;
+    
+    printf("Played %d %s tournaments of %d players on %d threads in %.2f s\n",
+           tournaments, variant_info((Variant)variant)->name, players, threads, elapsed);
+    printf("  %.1f tournaments/s  %.1f hands per tournament\n",
+           tournaments / elapsed, (double)hands / tournaments);
+    
+    /* Every seat runs the same AI, so each share should sit near 1 / players */
+    double lowest = 1.0, highest = 0.0;
+    for (int p = 0; p < players; p++) {
+        double share = prize[p] / tournaments;
+        if (share < lowest) lowest = share;
+        if (share > highest) highest = share;
+    }
+    printf("  prize share per seat %.3f - %.3f (fair share %.3f)\n", lowest, highest, 1.0 / players);
+    
+    TRACE_FLUSH();
+    return 0;
+}
@@ -0,0 +1,166 @@
+/*
+ * Poker Trace - per-thread event buffers and Chrome Trace JSON writer
+ * Compiled to an empty translation unit unless POKER_TRACE is defined.
+ */
+
+#ifdef POKER_TRACE
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#define TRACE_EVENTS_PER_THREAD 65536
+#define TRACE_THREAD_NAME_LEN 32
+
+/* One completed scope */
+typedef struct {
+    const char* name;
+    uint64_t start_ns;
+    uint64_t dur_ns;
+} TraceEvent;
+
+/* Per-thread event buffer - only its owning thread appends to it */
+typedef struct TraceBuffer {
+    struct TraceBuffer* next;
+    uint32_t tid;
+    char thread_name[TRACE_THREAD_NAME_LEN];
+    int count;
+    int dropped;
+    TraceEvent events[TRACE_EVENTS_PER_THREAD];
+} TraceBuffer;
+
+/* All buffers ever created, pushed lock-free as threads first record */
+static TraceBuffer* all_buffers = NULL;
+static uint32_t next_tid = 1;
+
+static __thread TraceBuffer* thread_buffer = NULL;
+
+/* Monotonic clock in nanoseconds */
+static uint64_t trace_now_ns() {
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER now;
+    if (freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (uint64_t)((double)now.QuadPart * 1e9 / (double)freq.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/* Get (or lazily create and register) the calling thread's buffer */
+static TraceBuffer* get_thread_buffer() {
+    if (thread_buffer) return thread_buffer;
+    
+    TraceBuffer* buf = calloc(1, sizeof(TraceBuffer));
+    if (!buf) return NULL;
+    buf->tid = __atomic_fetch_add(&next_tid, 1, __ATOMIC_RELAXED);
+    snprintf(buf->thread_name, sizeof(buf->thread_name), "thread %u", buf->tid);
+    
+    buf->next = __atomic_load_n(&all_buffers, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&all_buffers, &buf->next, buf, 1,
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+    }
+    
+    thread_buffer = buf;
+    return buf;
+}
+
+TraceScope trace_scope_begin(const char* name) {
+    TraceScope scope = {name, trace_now_ns()};
+    return scope;
+}
+
+void trace_scope_end(TraceScope* scope) {
+    uint64_t end = trace_now_ns();
+    TraceBuffer* buf = get_thread_buffer();
+    if (!buf) return;
+    
+    /* A full buffer drops events rather than stalling the caller */
+    if (buf->count >= TRACE_EVENTS_PER_THREAD) {
+        buf->dropped++;
+        return;
+    }
+    
+    TraceEvent* ev = &buf->events[buf->count++];
+    ev->name = scope->name;
+    ev->start_ns = scope->start_ns;
+    ev->dur_ns = end - scope->start_ns;
+}
+
+void trace_set_thread_name(const char* name) {
+    TraceBuffer* buf = get_thread_buffer();
+    if (!buf) return;
+    strncpy(buf->thread_name, name, TRACE_THREAD_NAME_LEN - 1);
+    buf->thread_name[TRACE_THREAD_NAME_LEN - 1] = '\0';
+}
+
+/*
+ * Write every thread's events as Chrome Trace Event JSON to $POKER_TRACE_FILE,
+ * or TRACE_DEFAULT_FILE when unset - returns 0 on success
+ */
+int trace_flush() {
+    const char* path = getenv("POKER_TRACE_FILE");
+    if (!path || !*path) path = TRACE_DEFAULT_FILE;
+    
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        printf("Failed to open trace file %s\n", path);
+        return -1;
+    }
+    
+    /* Timestamps are written relative to the earliest recorded event */
+    TraceBuffer* head = __atomic_load_n(&all_buffers, __ATOMIC_ACQUIRE);
+    uint64_t epoch = UINT64_MAX;
+    for (TraceBuffer* buf = head; buf; buf = buf->next) {
+        for (int i = 0; i < buf->count; i++) {
+            if (buf->events[i].start_ns < epoch) epoch = buf->events[i].start_ns;
+        }
+    }
+    
+    int first = 1;
+    int total = 0;
+    int dropped = 0;
+    
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    for (TraceBuffer* buf = head; buf; buf = buf->next) {
+        fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                first ? "" : ",\n", buf->tid, buf->thread_name);
+        first = 0;
+            
+        for (int i = 0; i < buf->count; i++) {
+            TraceEvent* ev = &buf->events[i];
+            fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                    ev->name, buf->tid, (ev->start_ns - epoch) / 1000.0, ev->dur_ns / 1000.0);
+        }
+        total += buf->count;
+        dropped += buf->dropped;
+    }
+    fprintf(f, "\n]}\n");
+    fclose(f);
+    
+    printf("Wrote %d trace events to %s", total, path);
+    if (dropped > 0) printf(" (%d dropped, buffer full)", dropped);
+    printf("\n");
+    return 0;
+}
+
+#else
+
+/* ISO C forbids an empty translation unit */
+typedef int trace_disabled;
+
+#endif
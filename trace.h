@@ -0,0 +1,61 @@
+/*
+ * Poker Trace - scoped timing instrumentation
+ * Writes Chrome Trace Event JSON (chrome://tracing, Perfetto)
+ *
+ * Build with -DPOKER_TRACE to enable. Without it every macro expands to
+ * nothing, so instrumented code costs nothing in normal builds.
+ *
+ *   void evaluate(...) {
+ *       TRACE_SCOPE("evaluate_hand");
+ *       ...
+ *   }
+ *
+ * Each thread records into its own buffer with no locking; buffers are
+ * only walked by trace_flush(), which should run once the other threads
+ * have stopped recording (normally at shutdown). The output file is
+ * $POKER_TRACE_FILE, or TRACE_DEFAULT_FILE when that is unset.
+ */
+
+#ifndef POKER_TRACE_H
+#define POKER_TRACE_H
+
+#include <stdint.h>
+
+#define TRACE_DEFAULT_FILE "poker_trace.json"
+
+#ifdef POKER_TRACE
+
+#if !defined(__GNUC__)
+#error "POKER_TRACE needs GCC or Clang (TRACE_SCOPE uses the cleanup attribute)"
+#endif
+
+/* Open scope - lives on the caller's stack until the enclosing block exits */
+typedef struct {
+    const char* name;
+    uint64_t start_ns;
+} TraceScope;
+
+TraceScope trace_scope_begin(const char* name);
+void trace_scope_end(TraceScope* scope);
+void trace_set_thread_name(const char* name);
+int trace_flush();
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+/* Time from here to the end of the enclosing block; name must be a string literal */
+#define TRACE_SCOPE(name) \
+    TraceScope TRACE_CONCAT(trace_scope_, __LINE__) \
+        __attribute__((cleanup(trace_scope_end))) = trace_scope_begin(name)
+#define TRACE_THREAD_NAME(name) trace_set_thread_name(name)
+#define TRACE_FLUSH() trace_flush()
+
+#else
+
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+#define TRACE_FLUSH() ((void)0)
+
+#endif
+
+#endif